@@ -9,6 +9,7 @@
 #include "servermanager/entity/custom/CustomCreeper.h"
 #include "servermanager/entity/custom/CustomArrow.h"
 #include "servermanager/level/custom/CustomLevel.h"
+#include "servermanager/level/custom/CustomLevelStorage.h"
 #include "servermanager/network/custom/CustomServerNetworkHandler.h"
 #include "servermanager/network/custom/CustomRakNetInstance.h"
 
@@ -24,6 +25,7 @@ JNIEXPORT jint JNI_OnLoad(JavaVM *vm, void *reserved)
 	CustomCreeper::setupHooks();
 	CustomArrow::setupHooks();
 	CustomLevel::setupHooks();
+	CustomLevelStorage::setupHooks();
 	CustomRakNetInstance::setupHooks();
 	CustomServerNetworkHandler::setupHooks();
 
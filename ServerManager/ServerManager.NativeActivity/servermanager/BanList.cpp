@@ -7,6 +7,7 @@
 BanList::BanList(const std::string &file)
 {
 	this->file = file;
+	this->persistence = NULL;
 }
 
 BanList::~BanList()
@@ -15,21 +16,50 @@ BanList::~BanList()
 		delete entry;
 
 	banEntries.clear();
+	banIndex.clear();
+	banRanges.clear();
 }
 
 BanEntry *BanList::getBanEntry(const std::string &target) const
 {
-	for(BanEntry *entry : banEntries)
-	{
-		if(!entry->getTarget().compare(target))
-			return entry;
-	}
+	auto it = banIndex.find(getKey(target));
+	if(it != banIndex.end())
+		return it->second;
 	return NULL;
 }
 
 void BanList::add(BanEntry *entry)
 {
-	banEntries.push_back(entry);
+	std::lock_guard<std::mutex> lock(mutex);
+
+	insert(entry);
+	persist(ListJournal::OP_ADD, entry->getString());
+}
+
+void BanList::insert(BanEntry *entry)
+{
+	std::string key = getKey(entry->getTarget());
+
+	auto it = banIndex.find(key);
+	if(it != banIndex.end())
+	{
+		if(it->second == entry)
+			return;
+
+		// a new ban for the same target replaces the old one but keeps its position
+		*std::find(banEntries.begin(), banEntries.end(), it->second) = entry;
+		delete it->second;
+		it->second = entry;
+	}
+	else
+	{
+		banEntries.push_back(entry);
+		banIndex[key] = entry;
+	}
+
+	IPRangeTree::Range range;
+	if(IPRangeTree::parse(entry->getTarget(), range))
+		banRanges.insert(range, entry);
 }
 
 BanEntry *BanList::addBan(const std::string &target, const std::string &reason, const std::string &source)
@@ -40,37 +70,76 @@ BanEntry *BanList::addBan(const std::string &target, const std::string &reason,
 	if(!source.empty())
 		entry->setSource(source);
 
-	banEntries.push_back(entry);
+	add(entry);
 
 	return entry;
 }
 
-std::vector<BanEntry *> BanList::getBanEntries() const
+const std::vector<BanEntry *> &BanList::getBanEntries() const
 {
 	return banEntries;
 }
 
 bool BanList::isBanned(const std::string &target) const
 {
-	for(BanEntry *entry : banEntries)
-	{
-		if(!entry->getTarget().compare(target))
-			return true;
-	}
-	return false;
+	return banIndex.find(getKey(target)) != banIndex.end();
 }
 
-void BanList::pardon(const std::string &target)
+BanEntry *BanList::matchAddress(const std::string &address) const
 {
-	for(BanEntry *entry : banEntries)
+	return banRanges.match(address);
+}
+
+bool BanList::pardon(const std::string &target)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if(!erase(target))
+		return false;
+
+	persist(ListJournal::OP_REMOVE, target);
+	return true;
+}
+
+bool BanList::erase(const std::string &target)
+{
+	auto it = banIndex.find(getKey(target));
+	if(it == banIndex.end())
+		return false;
+
+	BanEntry *entry = it->second;
+	banIndex.erase(it);
+
+	IPRangeTree::Range range;
+	if(IPRangeTree::parse(target, range))
+		banRanges.remove(range);
+
+	banEntries.erase(std::find(banEntries.begin(), banEntries.end(), entry));
+	delete entry;
+	return true;
+}
+
+void BanList::persist(char op, const std::string &record)
+{
+	if(journal.isOpen())
 	{
-		if(!entry->getTarget().compare(target))
-		{
-			delete entry;
-			banEntries.erase(std::find(banEntries.begin(), banEntries.end(), entry));
-			break;
-		}
+		journal.append(op, record);
+		if(!journal.needsCompaction())
+			return;
 	}
+
+	if(persistence)
+		persistence->markDirty(this);
+}
+
+// "1.2.3.*", "1.2.3.0/24" and "1.2.3.5/24" are the same range and must share one index slot,
+// otherwise banning one spelling clobbers the tree node of another and a pardon lifts both
+std::string BanList::getKey(const std::string &target)
+{
+	IPRangeTree::Range range;
+	if(IPRangeTree::parse(target, range))
+		return IPRangeTree::format(range);
+	return target;
 }
 
 void BanList::load(const std::string &path)
@@ -89,17 +158,64 @@ void BanList::load(const std::string &path)
 			continue;
 
 		BanEntry *entry = BanEntry::fromString(line);
-		banEntries.push_back(entry);
+		if(entry)
+			insert(entry);
 	}
 	ifs.close();
 }
 
+void BanList::attach(PersistenceWorker *persistence, bool useJournal)
+{
+	this->persistence = persistence;
+
+	if(!useJournal || !journal.open(filePath + ".journal"))
+		return;
+
+	int records;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		records = journal.replay([this](char op, const std::string &record) {
+			if(op == ListJournal::OP_REMOVE)
+				erase(record);
+			else
+			{
+				BanEntry *entry = BanEntry::fromString(record);
+				if(entry)
+					insert(entry);
+			}
+		});
+	}
+
+	// fold whatever the last session left in the journal into the snapshot
+	if(records > 0)
+		persistence->markDirty(this);
+}
+
 void BanList::save()
 {
-	std::ofstream ofs(filePath.c_str());
-	ofs << "# victim name | banned by | reason" << std::endl << std::endl;
+	PersistenceWorker::save(this);
+}
+
+std::string BanList::getFilePath() const
+{
+	return filePath;
+}
+
+std::string BanList::serialize()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	// changes made after this point land in a fresh journal, not in the snapshot
+	journal.rotate();
 
+	std::string contents = "# victim name | banned by | reason\n\n";
 	for(BanEntry *entry : banEntries)
-		ofs << entry->getString() << std::endl;
-	ofs.close();
+		contents.append(entry->getString()).append("\n");
+	return contents;
+}
+
+void BanList::onSaved()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	journal.finishCompaction();
 }
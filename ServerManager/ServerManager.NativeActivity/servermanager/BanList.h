@@ -2,10 +2,16 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <mutex>
+
+#include "IPRangeTree.h"
+#include "util/PersistenceWorker.h"
+#include "util/ListJournal.h"
 
 class BanEntry;
 
-class BanList
+class BanList : public PersistenceWorker::Target
 {
 public:
 	enum Type
@@ -19,6 +25,12 @@ private:
 	std::string filePath;
 
 	std::vector<BanEntry *> banEntries;
+	std::unordered_map<std::string, BanEntry *> banIndex;
+	IPRangeTree banRanges;
+	mutable std::mutex mutex;
+
+	PersistenceWorker *persistence;
+	ListJournal journal;
 
 public:
 	BanList(const std::string &file);
@@ -29,12 +41,25 @@ public:
 	void add(BanEntry *entry);
 	BanEntry *addBan(const std::string &target, const std::string &reason, const std::string &source);
 
-	std::vector<BanEntry *> getBanEntries() const;
+	const std::vector<BanEntry *> &getBanEntries() const;
 
 	bool isBanned(const std::string &target) const;
+	BanEntry *matchAddress(const std::string &address) const;
 
-	void pardon(const std::string &target);
+	bool pardon(const std::string &target);
 
 	void load(const std::string &path);
+	void attach(PersistenceWorker *persistence, bool useJournal);
 	void save();
+
+	std::string getFilePath() const;
+	std::string serialize();
+	void onSaved();
+
+private:
+	void insert(BanEntry *entry);
+	bool erase(const std::string &target);
+	void persist(char op, const std::string &record);
+
+	static std::string getKey(const std::string &target);
 };
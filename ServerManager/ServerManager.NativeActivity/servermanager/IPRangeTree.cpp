@@ -0,0 +1,167 @@
+#include <cstring>
+#include <cstdlib>
+#include <arpa/inet.h>
+
+#include "IPRangeTree.h"
+#include "util/SMUtil.h"
+
+IPRangeTree::IPRangeTree()
+{
+	clear();
+}
+
+void IPRangeTree::insert(const Range &range, BanEntry *entry)
+{
+	int node = 0;
+	for(int i = 0; i < range.prefixLength; ++i)
+	{
+		int bit = getBit(range, i);
+		if(nodes[node].children[bit] < 0)
+		{
+			Node child = {{-1, -1}, NULL};
+			nodes[node].children[bit] = (int)nodes.size();
+			nodes.push_back(child);
+		}
+		node = nodes[node].children[bit];
+	}
+	nodes[node].entry = entry;
+}
+
+void IPRangeTree::remove(const Range &range)
+{
+	int node = 0;
+	for(int i = 0; i < range.prefixLength; ++i)
+	{
+		node = nodes[node].children[getBit(range, i)];
+		if(node < 0)
+			return;
+	}
+	nodes[node].entry = NULL;
+}
+
+void IPRangeTree::clear()
+{
+	Node root = {{-1, -1}, NULL};
+	nodes.clear();
+	nodes.push_back(root);
+}
+
+BanEntry *IPRangeTree::match(const std::string &address) const
+{
+	Range range;
+	if(!parse(address, range))
+		return NULL;
+
+	return match(range);
+}
+
+BanEntry *IPRangeTree::match(const Range &address) const
+{
+	BanEntry *found = nodes[0].entry;
+
+	int node = 0;
+	for(int i = 0; i < address.prefixLength; ++i)
+	{
+		node = nodes[node].children[getBit(address, i)];
+		if(node < 0)
+			break;
+
+		if(nodes[node].entry)
+			found = nodes[node].entry;
+	}
+	return found;
+}
+
+// accepts "a.b.c.d", "a.b.c.d/n", "a.b.c.*" and IPv6 addresses with an optional "/n"
+bool IPRangeTree::parse(const std::string &target, Range &range)
+{
+	std::string address = SMUtil::trim(target);
+	int prefixLength = -1;
+
+	size_t slash = address.find('/');
+	if(slash != std::string::npos)
+	{
+		std::string prefix = address.substr(slash + 1);
+		if(prefix.empty() || !SMUtil::is_number(prefix) || prefix[0] == '-' || prefix[0] == '+')
+			return false;
+
+		prefixLength = SMUtil::toInt(prefix);
+		address.erase(slash);
+	}
+
+	size_t scope = address.find('%');
+	if(scope != std::string::npos)
+		address.erase(scope);
+
+	memset(range.address, 0, sizeof(range.address));
+
+	if(address.find(':') != std::string::npos)
+	{
+		if(inet_pton(AF_INET6, address.c_str(), range.address) != 1)
+			return false;
+
+		if(prefixLength < 0)
+			prefixLength = 128;
+		if(prefixLength > 128)
+			return false;
+
+		range.prefixLength = prefixLength;
+		return true;
+	}
+
+	int wildcards = 0;
+	while(address.length() >= 2 && !address.compare(address.length() - 2, 2, ".*"))
+	{
+		address.erase(address.length() - 2);
+		wildcards++;
+	}
+	if(wildcards > 0)
+	{
+		if(prefixLength >= 0)
+			return false;
+
+		for(int i = 0; i < wildcards; ++i)
+			address += ".0";
+		prefixLength = 32 - wildcards * 8;
+	}
+
+	in_addr v4;
+	if(inet_pton(AF_INET, address.c_str(), &v4) != 1)
+		return false;
+
+	if(prefixLength < 0)
+		prefixLength = 32;
+	if(prefixLength > 32)
+		return false;
+
+	range.address[10] = 0xff;
+	range.address[11] = 0xff;
+	memcpy(range.address + 12, &v4, 4);
+	range.prefixLength = prefixLength + 96;
+	return true;
+}
+
+// spells a range one way only: host bits cleared, IPv4 in dotted form, prefix always present
+std::string IPRangeTree::format(const Range &range)
+{
+	unsigned char address[16];
+	memcpy(address, range.address, sizeof(address));
+	for(int i = range.prefixLength; i < 128; ++i)
+		address[i / 8] &= ~(1 << (7 - i % 8));
+
+	static const unsigned char mapped[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+	char text[INET6_ADDRSTRLEN];
+	if(range.prefixLength >= 96 && !memcmp(address, mapped, sizeof(mapped)))
+	{
+		inet_ntop(AF_INET, address + 12, text, sizeof(text));
+		return std::string(text) + "/" + SMUtil::toString(range.prefixLength - 96);
+	}
+
+	inet_ntop(AF_INET6, address, text, sizeof(text));
+	return std::string(text) + "/" + SMUtil::toString(range.prefixLength);
+}
+
+int IPRangeTree::getBit(const Range &range, int index)
+{
+	return (range.address[index / 8] >> (7 - index % 8)) & 1;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+class BanEntry;
+
+class IPRangeTree
+{
+public:
+	// IPv4 addresses are stored as IPv4-mapped IPv6 addresses, so one tree covers both families
+	struct Range
+	{
+		unsigned char address[16];
+		int prefixLength;
+	};
+
+private:
+	struct Node
+	{
+		int children[2];
+		BanEntry *entry;
+	};
+
+	std::vector<Node> nodes;
+
+public:
+	IPRangeTree();
+
+	void insert(const Range &range, BanEntry *entry);
+	void remove(const Range &range);
+	void clear();
+
+	BanEntry *match(const std::string &address) const;
+	BanEntry *match(const Range &address) const;
+
+	static bool parse(const std::string &target, Range &range);
+	static std::string format(const Range &range);
+
+private:
+	static int getBit(const Range &range, int index);
+};
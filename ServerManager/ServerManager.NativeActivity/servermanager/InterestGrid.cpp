@@ -0,0 +1,142 @@
+#include <cmath>
+#include <algorithm>
+
+#include "InterestGrid.h"
+
+InterestGrid::InterestGrid()
+{
+	radius = 160.0f;
+}
+
+void InterestGrid::setRadius(float radius)
+{
+	if(radius == this->radius || radius <= 0.0f)
+		return;
+
+	this->radius = radius;
+
+	// the cell size follows the radius, so every cell has to be rebuilt
+	cells.clear();
+	for(auto &it : entries)
+	{
+		Entry &entry = it.second;
+		entry.cell = getCellKey(entry.dimension, toCell(entry.x), toCell(entry.z));
+		cells[entry.cell].push_back(it.first);
+	}
+}
+
+float InterestGrid::getRadius() const
+{
+	return radius;
+}
+
+void InterestGrid::update(SMPlayer *player, int dimension, float x, float z)
+{
+	long long cell = getCellKey(dimension, toCell(x), toCell(z));
+
+	auto it = entries.find(player);
+	if(it == entries.end())
+	{
+		Entry entry = {dimension, cell, x, z, 0};
+		entries[player] = entry;
+		cells[cell].push_back(player);
+		return;
+	}
+
+	Entry &entry = it->second;
+	if(entry.cell != cell)
+	{
+		unlink(player, entry.cell);
+		cells[cell].push_back(player);
+		entry.cell = cell;
+	}
+	entry.dimension = dimension;
+	entry.x = x;
+	entry.z = z;
+}
+
+void InterestGrid::remove(SMPlayer *player)
+{
+	auto it = entries.find(player);
+	if(it == entries.end())
+		return;
+
+	unlink(player, it->second.cell);
+	entries.erase(it);
+}
+
+void InterestGrid::clear()
+{
+	entries.clear();
+	cells.clear();
+}
+
+void InterestGrid::getRecipients(SMPlayer *source, std::vector<SMPlayer *> &recipients)
+{
+	recipients.clear();
+
+	auto sourceIt = entries.find(source);
+	if(sourceIt == entries.end())
+		return;
+
+	Entry &origin = sourceIt->second;
+	bool includeFar = ++origin.moves % FAR_UPDATE_INTERVAL == 0;
+	float radiusSq = radius * radius;
+
+	if(includeFar)
+	{
+		for(auto &it : entries)
+		{
+			if(it.first != source && it.second.dimension == origin.dimension)
+				recipients.push_back(it.first);
+		}
+		return;
+	}
+
+	// cells are as wide as the radius, so the 3x3 block around the source covers it
+	int cellX = toCell(origin.x);
+	int cellZ = toCell(origin.z);
+	for(int dx = -1; dx <= 1; ++dx)
+	{
+		for(int dz = -1; dz <= 1; ++dz)
+		{
+			auto cellIt = cells.find(getCellKey(origin.dimension, cellX + dx, cellZ + dz));
+			if(cellIt == cells.end())
+				continue;
+
+			for(SMPlayer *player : cellIt->second)
+			{
+				if(player == source)
+					continue;
+
+				const Entry &entry = entries[player];
+				float distX = entry.x - origin.x;
+				float distZ = entry.z - origin.z;
+				if(distX * distX + distZ * distZ <= radiusSq)
+					recipients.push_back(player);
+			}
+		}
+	}
+}
+
+int InterestGrid::toCell(float coord) const
+{
+	return (int)std::floor(coord / radius);
+}
+
+long long InterestGrid::getCellKey(int dimension, int cellX, int cellZ)
+{
+	return ((long long)dimension << 48) ^ ((long long)(cellX & 0xFFFFFF) << 24) ^ (long long)(cellZ & 0xFFFFFF);
+}
+
+void InterestGrid::unlink(SMPlayer *player, long long cell)
+{
+	auto it = cells.find(cell);
+	if(it == cells.end())
+		return;
+
+	std::vector<SMPlayer *> &players = it->second;
+	players.erase(std::find(players.begin(), players.end(), player));
+	if(players.empty())
+		cells.erase(it);
+}
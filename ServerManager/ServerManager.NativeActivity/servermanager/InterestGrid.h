@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+class SMPlayer;
+
+// uniform grid of player positions, players are only used as keys so any pointer can stand in for one
+class InterestGrid
+{
+public:
+	// players outside the radius still see every n-th move so they keep a rough position
+	static const unsigned int FAR_UPDATE_INTERVAL = 4;
+
+private:
+	struct Entry
+	{
+		int dimension;
+		long long cell;
+		float x;
+		float z;
+		unsigned int moves;
+	};
+
+	float radius;
+	std::unordered_map<SMPlayer *, Entry> entries;
+	std::unordered_map<long long, std::vector<SMPlayer *>> cells;
+
+public:
+	InterestGrid();
+
+	void setRadius(float radius);
+	float getRadius() const;
+
+	void update(SMPlayer *player, int dimension, float x, float z);
+	void remove(SMPlayer *player);
+	void clear();
+
+	void getRecipients(SMPlayer *source, std::vector<SMPlayer *> &recipients);
+
+private:
+	int toCell(float coord) const;
+	static long long getCellKey(int dimension, int cellX, int cellZ);
+	void unlink(SMPlayer *player, long long cell);
+};
@@ -0,0 +1,155 @@
+#include <cctype>
+
+#include "PlayerNameIndex.h"
+
+PlayerNameIndex::PlayerNameIndex()
+{
+	clear();
+}
+
+void PlayerNameIndex::add(SMPlayer *player, const std::string &name)
+{
+	Entry entry = {player, name.length()};
+	nodes[0].entries.push_back(entry);
+
+	for(size_t start = 0; start < name.length(); ++start)
+	{
+		int node = 0;
+		for(size_t i = start; i < name.length(); ++i)
+		{
+			node = getOrCreateChild(node, fold(name[i]));
+
+			std::vector<Entry> &entries = nodes[node].entries;
+			if(entries.empty() || entries.back().player != player)
+				entries.push_back(entry);
+		}
+	}
+}
+
+void PlayerNameIndex::remove(SMPlayer *player, const std::string &name)
+{
+	std::vector<int> path;
+
+	for(size_t start = 0; start <= name.length(); ++start)
+	{
+		path.clear();
+		path.push_back(0);
+
+		for(size_t i = start; i < name.length(); ++i)
+		{
+			int child = getChild(path.back(), fold(name[i]));
+			if(child < 0)
+				break;
+
+			path.push_back(child);
+		}
+
+		for(int i = (int)path.size() - 1; i >= 0; --i)
+		{
+			std::vector<Entry> &entries = nodes[path[i]].entries;
+			for(auto it = entries.begin(); it != entries.end(); ++it)
+			{
+				if(it->player == player)
+				{
+					entries.erase(it);
+					break;
+				}
+			}
+
+			if(i > 0 && entries.empty() && nodes[path[i]].children.empty())
+			{
+				removeChild(path[i - 1], fold(name[start + i - 1]));
+				freeNodes.push_back(path[i]);
+			}
+		}
+	}
+}
+
+void PlayerNameIndex::clear()
+{
+	nodes.clear();
+	freeNodes.clear();
+	nodes.push_back(Node());
+}
+
+const std::vector<PlayerNameIndex::Entry> *PlayerNameIndex::getCandidates(const std::string &partialName) const
+{
+	int node = 0;
+	for(char c : partialName)
+	{
+		node = getChild(node, fold(c));
+		if(node < 0)
+			return NULL;
+	}
+
+	if(nodes[node].entries.empty())
+		return NULL;
+
+	return &nodes[node].entries;
+}
+
+SMPlayer *PlayerNameIndex::getBestMatch(const std::string &partialName) const
+{
+	const std::vector<Entry> *candidates = getCandidates(partialName);
+	if(!candidates)
+		return NULL;
+
+	const Entry *found = NULL;
+	for(const Entry &entry : *candidates)
+	{
+		if(!found || entry.length < found->length)
+			found = &entry;
+
+		if(entry.length == partialName.length())
+			break;
+	}
+	return found->player;
+}
+
+int PlayerNameIndex::getChild(int node, char c) const
+{
+	for(const std::pair<char, int> &child : nodes[node].children)
+		if(child.first == c)
+			return child.second;
+	return -1;
+}
+
+int PlayerNameIndex::getOrCreateChild(int node, char c)
+{
+	int child = getChild(node, c);
+	if(child >= 0)
+		return child;
+
+	if(!freeNodes.empty())
+	{
+		child = freeNodes.back();
+		freeNodes.pop_back();
+		nodes[child] = Node();
+	}
+	else
+	{
+		child = (int)nodes.size();
+		nodes.push_back(Node());
+	}
+
+	nodes[node].children.push_back(std::make_pair(c, child));
+	return child;
+}
+
+void PlayerNameIndex::removeChild(int node, char c)
+{
+	std::vector<std::pair<char, int>> &children = nodes[node].children;
+	for(auto it = children.begin(); it != children.end(); ++it)
+	{
+		if(it->first == c)
+		{
+			children.erase(it);
+			break;
+		}
+	}
+}
+
+char PlayerNameIndex::fold(char c)
+{
+	return (char)::tolower((unsigned char)c);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+
+class SMPlayer;
+
+class PlayerNameIndex
+{
+public:
+	struct Entry
+	{
+		SMPlayer *player;
+		size_t length;
+	};
+
+private:
+	// suffix trie over lowercased names, every node lists the players whose name contains the path to it
+	struct Node
+	{
+		std::vector<std::pair<char, int>> children;
+		std::vector<Entry> entries;
+	};
+
+	std::vector<Node> nodes;
+	std::vector<int> freeNodes;
+
+public:
+	PlayerNameIndex();
+
+	void add(SMPlayer *player, const std::string &name);
+	void remove(SMPlayer *player, const std::string &name);
+	void clear();
+
+	const std::vector<Entry> *getCandidates(const std::string &partialName) const;
+	SMPlayer *getBestMatch(const std::string &partialName) const;
+
+private:
+	int getChild(int node, char c) const;
+	int getOrCreateChild(int node, char c);
+	void removeChild(int node, char c);
+
+	static char fold(char c);
+};
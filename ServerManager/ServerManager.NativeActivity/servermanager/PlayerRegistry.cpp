@@ -0,0 +1,58 @@
+#include "PlayerRegistry.h"
+#include "util/SMUtil.h"
+
+bool PlayerRegistry::add(SMPlayer *player, Player *handle, unsigned long long guid, const std::string &name)
+{
+	if(playersByHandle.find(handle) != playersByHandle.end())
+		return false;
+
+	playersByHandle[handle] = player;
+	playersByGuid[guid] = player;
+	playersByName[SMUtil::toLower(name)] = player;
+	return true;
+}
+
+void PlayerRegistry::remove(SMPlayer *player, Player *handle, unsigned long long guid, const std::string &name)
+{
+	playersByHandle.erase(handle);
+
+	// a newer player may have taken over the GUID or the name, its entry stays
+	auto guidIt = playersByGuid.find(guid);
+	if(guidIt != playersByGuid.end() && guidIt->second == player)
+		playersByGuid.erase(guidIt);
+
+	auto nameIt = playersByName.find(SMUtil::toLower(name));
+	if(nameIt != playersByName.end() && nameIt->second == player)
+		playersByName.erase(nameIt);
+}
+
+void PlayerRegistry::clear()
+{
+	playersByHandle.clear();
+	playersByGuid.clear();
+	playersByName.clear();
+}
+
+SMPlayer *PlayerRegistry::getByHandle(Player *handle) const
+{
+	auto it = playersByHandle.find(handle);
+	if(it != playersByHandle.end())
+		return it->second;
+	return NULL;
+}
+
+SMPlayer *PlayerRegistry::getByGuid(unsigned long long guid) const
+{
+	auto it = playersByGuid.find(guid);
+	if(it != playersByGuid.end())
+		return it->second;
+	return NULL;
+}
+
+SMPlayer *PlayerRegistry::getByName(const std::string &name) const
+{
+	auto it = playersByName.find(SMUtil::toLower(name));
+	if(it != playersByName.end())
+		return it->second;
+	return NULL;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+class Player;
+class SMPlayer;
+
+// online players by handle, RakNet GUID and lowercase name, every lookup is one hash probe
+class PlayerRegistry
+{
+private:
+	std::unordered_map<Player *, SMPlayer *> playersByHandle;
+	std::unordered_map<unsigned long long, SMPlayer *> playersByGuid;
+	std::unordered_map<std::string, SMPlayer *> playersByName;
+
+public:
+	// false if the handle is already registered
+	bool add(SMPlayer *player, Player *handle, unsigned long long guid, const std::string &name);
+	void remove(SMPlayer *player, Player *handle, unsigned long long guid, const std::string &name);
+	void clear();
+
+	SMPlayer *getByHandle(Player *handle) const;
+	SMPlayer *getByGuid(unsigned long long guid) const;
+	SMPlayer *getByName(const std::string &name) const;
+};
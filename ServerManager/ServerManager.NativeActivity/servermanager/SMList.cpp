@@ -1,11 +1,14 @@
 #include <algorithm>
 #include <fstream>
+#include <cctype>
 
 #include "SMList.h"
+#include "util/SMUtil.h"
 
 SMList::SMList(const std::string &file)
 {
 	this->file = file;
+	this->persistence = NULL;
 }
 
 void SMList::load(const std::string &path)
@@ -23,17 +26,61 @@ void SMList::load(const std::string &path)
 		if(line.empty())
 			continue;
 
-		list.push_back(line);
+		insert(line);
 	}
 	ifs.close();
 }
 
+void SMList::attach(PersistenceWorker *persistence, bool useJournal)
+{
+	this->persistence = persistence;
+
+	if(!useJournal || !journal.open(filePath + ".journal"))
+		return;
+
+	int records;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		records = journal.replay([this](char op, const std::string &element) {
+			if(op == ListJournal::OP_ADD)
+				insert(element);
+			else
+				erase(element);
+		});
+	}
+
+	// fold whatever the last session left in the journal into the snapshot
+	if(records > 0)
+		persistence->markDirty(this);
+}
+
 void SMList::save()
 {
-	std::ofstream ofs(filePath.c_str());
-	for(auto str : list)
-		ofs << str << std::endl;
-	ofs.close();
+	PersistenceWorker::save(this);
+}
+
+std::string SMList::getFilePath() const
+{
+	return filePath;
+}
+
+std::string SMList::serialize()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	// changes made after this point land in a fresh journal, not in the snapshot
+	journal.rotate();
+
+	std::string contents;
+	for(auto &str : list)
+		contents.append(str).append("\n");
+	return contents;
+}
+
+void SMList::onSaved()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	journal.finishCompaction();
 }
 
 void SMList::reload()
@@ -42,27 +89,116 @@ void SMList::reload()
 }
 
 void SMList::add(const std::string &element)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if(insert(element))
+		persist(ListJournal::OP_ADD, element);
+}
+
+void SMList::remove(const std::string &element)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if(erase(element))
+		persist(ListJournal::OP_REMOVE, element);
+}
+
+bool SMList::insert(const std::string &element)
 {
 	if(isExist(element))
-		return;
+		return false;
 
 	list.push_back(element);
+	index.insert(std::make_pair(hashFolded(element.c_str(), element.length()), SMUtil::toLower(element)));
+	return true;
 }
 
-void SMList::remove(const std::string &element)
+bool SMList::erase(const std::string &element)
 {
-	if(!isExist(element))
-		return;
+	bool erased = false;
+	std::string folded;
+
+	auto range = index.equal_range(hashFolded(element.c_str(), element.length()));
+	for(auto it = range.first; it != range.second; ++it)
+	{
+		if(equalsFolded(it->second, element.c_str(), element.length()))
+		{
+			folded.swap(it->second);
+			index.erase(it);
+			erased = true;
+			break;
+		}
+	}
 
-	list.erase(std::find(list.begin(), list.end(), element));
+	if(!erased)
+		return false;
+
+	// the stored spelling is folded in place while comparing, no lowercase copy per entry
+	for(auto it = list.begin(); it != list.end(); ++it)
+	{
+		if(equalsFolded(folded, it->c_str(), it->length()))
+		{
+			list.erase(it);
+			break;
+		}
+	}
+	return true;
+}
+
+void SMList::persist(char op, const std::string &element)
+{
+	if(journal.isOpen())
+	{
+		journal.append(op, element);
+		if(!journal.needsCompaction())
+			return;
+	}
+
+	if(persistence)
+		persistence->markDirty(this);
 }
 
 bool SMList::isExist(const std::string &element) const
 {
-	return std::find(list.begin(), list.end(), element) != list.end();
+	return isExist(element.c_str(), element.length());
+}
+
+// case-insensitive and allocation free, for callers on the packet path
+bool SMList::isExist(const char *element, size_t length) const
+{
+	auto range = index.equal_range(hashFolded(element, length));
+	for(auto it = range.first; it != range.second; ++it)
+	{
+		if(equalsFolded(it->second, element, length))
+			return true;
+	}
+	return false;
 }
 
 const std::vector<std::string> &SMList::getAll() const
 {
 	return list;
 }
+
+unsigned int SMList::hashFolded(const char *element, size_t length)
+{
+	unsigned int hash = 2166136261u;
+	for(size_t i = 0; i < length; ++i)
+	{
+		hash ^= (unsigned char)::tolower((unsigned char)element[i]);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+bool SMList::equalsFolded(const std::string &folded, const char *element, size_t length)
+{
+	if(folded.length() != length)
+		return false;
+
+	for(size_t i = 0; i < length; ++i)
+	{
+		if(folded[i] != (char)::tolower((unsigned char)element[i]))
+			return false;
+	}
+	return true;
+}
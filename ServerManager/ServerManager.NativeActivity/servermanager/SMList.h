@@ -2,25 +2,49 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <mutex>
 
-class SMList
+#include "util/PersistenceWorker.h"
+#include "util/ListJournal.h"
+
+class SMList : public PersistenceWorker::Target
 {
 private:
 	std::string file;
 	std::string filePath;
 	std::vector<std::string> list;
+	std::unordered_multimap<unsigned int, std::string> index;
+	mutable std::mutex mutex;
+
+	PersistenceWorker *persistence;
+	ListJournal journal;
 
 public:
 	SMList(const std::string &file);
 
 	void load(const std::string &path);
+	void attach(PersistenceWorker *persistence, bool useJournal);
 	void save();
 
+	std::string getFilePath() const;
+	std::string serialize();
+	void onSaved();
+
 	void reload();
 
 	void add(const std::string &element);
 	void remove(const std::string &element);
 	bool isExist(const std::string &element) const;
+	bool isExist(const char *element, size_t length) const;
 
 	const std::vector<std::string> &getAll() const;
+
+private:
+	bool insert(const std::string &element);
+	bool erase(const std::string &element);
+	void persist(char op, const std::string &element);
+
+	static unsigned int hashFolded(const char *element, size_t length);
+	static bool equalsFolded(const std::string &folded, const char *element, size_t length);
 };
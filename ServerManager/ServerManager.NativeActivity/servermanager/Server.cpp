@@ -1,7 +1,4 @@
-#include <limits>
 #include <algorithm>
-#include <curl/curl.h>
-#include <json/json.h>
 
 #include "Server.h"
 #include "ServerManager.h"
@@ -11,48 +8,79 @@
 #include "client/settings/SMOptions.h"
 #include "command/CommandMap.h"
 #include "command/Command.h"
+#include "command/AsyncCommandRunner.h"
 #include "level/SMLevel.h"
+#include "level/PlayerSaveQueue.h"
+#include "network/BroadcastQueue.h"
+#include "network/SerializedPacket.h"
 #include "entity/SMPlayer.h"
 #include "entity/SMLocalPlayer.h"
 #include "plugin/PluginManager.h"
 #include "plugin/Plugin.h"
 #include "plugin/PluginDescriptionFile.h"
+#include "scheduler/Scheduler.h"
 #include "util/SMUtil.h"
+#include "util/PersistenceWorker.h"
+#include "util/ThreadPool.h"
+#include "util/SkinValidator.h"
+#include "util/UpdateChecker.h"
 #include "version.h"
 #include "minecraftpe/client/Minecraft.h"
 #include "minecraftpe/entity/player/LocalPlayer.h"
 #include "minecraftpe/entity/EntityClassTree.h"
+#include "minecraftpe/level/BlockSource.h"
 #include "minecraftpe/network/PacketSender.h"
-#include "minecraftpe/network/protocol/TextPacket.h"
 #include "minecraftpe/network/ServerNetworkHandler.h"
 #include "minecraftpe/util/File.h"
+#include "raknet/RakNetTypes.h"
 
 Server::Server()
 {
 	ServerManager::setServer(this);
 
 	started = false;
+	updateNotified = false;
 	level = NULL;
 	server = NULL;
+	raknet = NULL;
+
+	threadPool = new ThreadPool;
 
 	options = new SMOptions("servermanager.txt");
 	banByName = new BanList("banned-players.txt");
 	banByIP = new BanList("banned-ips.txt");
 	operators = new SMList("ops.txt");
 	whitelist = new SMList("white-list.txt");
+	persistence = new PersistenceWorker(threadPool);
+	playerSaves = new PlayerSaveQueue;
 
 	commandMap = new CommandMap;
+	asyncCommands = new AsyncCommandRunner(threadPool);
+	scheduler = new Scheduler(threadPool);
 	pluginManager = new PluginManager(this, commandMap);
 
 	localPlayer = NULL;
 
-	newVersionCode = 0;
+	updateChecker = new UpdateChecker(threadPool);
+	broadcastQueue = new BroadcastQueue;
+	skinValidator = new SkinValidator(threadPool);
 }
 
 Server::~Server()
 {
 	pluginManager->clearPlugins();
 
+	// every task still queued runs before the objects it points at go away
+	threadPool->stop();
+
+	delete asyncCommands;
+	delete scheduler;
+	delete updateChecker;
+	delete broadcastQueue;
+	delete skinValidator;
+	delete playerSaves;
+	delete persistence;
+	delete threadPool;
 	delete options;
 	delete banByName;
 	delete banByIP;
@@ -69,6 +97,8 @@ void Server::init(Minecraft *server, const std::string &path)
 	pluginDir = serverDir + "plugins/";
 
 	load(serverDir);
+	threadPool->start();
+	persistence->start();
 
 	loadPlugins();
 	enablePlugins(PluginLoadOrder::STARTUP);
@@ -85,6 +115,23 @@ void Server::load(const std::string &path)
 	banByIP->load(path);
 	operators->load(path);
 	whitelist->load(path);
+
+	movementFilter.configure(options->getMoveMinDistance(), options->getMoveMinRotation(), options->getMoveMaxPerTick());
+
+	packetLimiter.setDefaultBudget(options->getPacketRate(), options->getPacketBurst());
+	packetLimiter.setKickThreshold(options->getPacketKickThreshold());
+	for (auto &it : options->getPacketLimits())
+		packetLimiter.setBudget(it.first, it.second.first, it.second.second);
+
+	loginQueue.configure(options->getLoginsPerTick(), options->getLoginsPerAddress());
+	announcer.setInterval(options->getAnnounceInterval());
+	scheduler->setTickBudget(options->getSchedulerTickBudget());
+
+	bool useJournal = options->useListJournal();
+	banByName->attach(persistence, useJournal);
+	banByIP->attach(persistence, useJournal);
+	operators->attach(persistence, useJournal);
+	whitelist->attach(persistence, useJournal);
 }
 
 void Server::start(LocalPlayer *localPlayer, Level *level)
@@ -95,24 +142,15 @@ void Server::start(LocalPlayer *localPlayer, Level *level)
 	this->level = new SMLevel(this, level);
 	this->localPlayer = new SMLocalPlayer(this, localPlayer);
 
-	players.push_back(this->localPlayer);
+	addPlayer(this->localPlayer);
 	entityList[localPlayer->getUniqueID()] = this->localPlayer;
 
 	started = true;
 
 	enablePlugins(PluginLoadOrder::POSTWORLD);
 
-	if (newVersionCode != 0 && newVersionCode != VERSION_CODE)
-	{
-		if (newVersionCode > VERSION_CODE)
-		{
-			this->localPlayer->sendMessage("[SM] 새로운 버전이 있습니다 : v" + newVersion + " Changelog:");
-			for (int i = 0; i < newChangelog.size(); i++)
-				this->localPlayer->sendMessage(" " + SMUtil::toString(i + 1) + ". " + newChangelog[i]);
-		}
-		else
-			this->localPlayer->sendMessage("[SM] 현재 개발 버전을 사용중입니다.");
-	}
+	// the check runs in the background from init, tick reports it once it has finished
+	updateNotified = false;
 }
 
 void Server::stop()
@@ -120,23 +158,59 @@ void Server::stop()
 	if (!started)
 		return;
 
-	started = false;
-
 	disablePlugins();
 
+	broadcastQueue->flush(getServer()->getPacketSender(), raknet);
+	started = false;
+
 	for (int i = 0; i < players.size(); ++i)
 		delete players[i];
 
 	players.clear();
+	playerRegistry.clear();
+	playerNames.clear();
+	commandMap->getCompleter()->clearPlayers();
+	interestGrid.clear();
+	packetLimiter.clear();
+	loginQueue.clear();
+
+	playerSaves->flush();
+	threadPool->waitIdle();
 
 	delete level;
 	level = NULL;
 
 	options->save();
-	banByName->save();
-	banByIP->save();
-	operators->save();
-	whitelist->save();
+	persistence->markDirty(banByName);
+	persistence->markDirty(banByIP);
+	persistence->markDirty(operators);
+	persistence->markDirty(whitelist);
+	persistence->flush();
+}
+
+void Server::tick()
+{
+	if (!started)
+		return;
+
+	movementFilter.tick();
+	loginQueue.process();
+	asyncCommands->process();
+	scheduler->tick();
+	playerSaves->tick();
+	announcer.update(raknet, getServerName(), PacketRateLimiter::currentMillis());
+	broadcastQueue->flush(getServer()->getPacketSender(), raknet);
+
+	if (!updateNotified && updateChecker->isFinished())
+	{
+		updateNotified = true;
+		notifyUpdate();
+	}
+}
+
+const std::string &Server::getServerDir() const
+{
+	return serverDir;
 }
 
 SMOptions *Server::getOptions() const
@@ -194,63 +268,39 @@ const std::vector<SMPlayer *> &Server::getOnlinePlayers() const
 
 SMPlayer *Server::getPlayer(const std::string &name) const
 {
-	SMPlayer *found = NULL;
-	std::string lowerName = SMUtil::toLower(name);
-	int delta = std::numeric_limits<int>::max();
-
-	for (int i = 0; i < players.size(); ++i)
-	{
-		SMPlayer *player = players[i];
-		std::string n = SMUtil::toLower(player->getName());
-		if (n.find(lowerName) != std::string::npos)
-		{
-			int curDelta = n.length() - lowerName.length();
-			if (curDelta < delta)
-			{
-				found = player;
-				delta = curDelta;
-			}
-
-			if (curDelta == 0)
-				break;
-		}
-	}
-	return found;
+	return playerNames.getBestMatch(name);
 }
 
 std::vector<SMPlayer *> Server::matchPlayer(const std::string &partialName) const
 {
-	std::string lname = SMUtil::toLower(partialName);
 	std::vector<SMPlayer *> matchedPlayers;
 
-	for (int i = 0; i < players.size(); ++i)
+	const std::vector<PlayerNameIndex::Entry> *candidates = playerNames.getCandidates(partialName);
+	if (!candidates)
+		return matchedPlayers;
+
+	for (const PlayerNameIndex::Entry &entry : *candidates)
 	{
-		SMPlayer *iterPlayer = players[i];
-		std::string iterPlayerName = iterPlayer->getName();
-		if (!iterPlayerName.compare(lname))
+		if (entry.length == partialName.length())
 		{
 			matchedPlayers.clear();
-			matchedPlayers.push_back(iterPlayer);
+			matchedPlayers.push_back(entry.player);
 
 			break;
 		}
-		else if (iterPlayerName.find(lname))
-			matchedPlayers.push_back(iterPlayer);
+		matchedPlayers.push_back(entry.player);
 	}
 	return matchedPlayers;
 }
 
-SMPlayer *Server::getPlayerExact(const std::string &name) const
+const std::vector<PlayerNameIndex::Entry> *Server::getPlayerCandidates(const std::string &partialName) const
 {
-	std::string lname = SMUtil::toLower(name);
+	return playerNames.getCandidates(partialName);
+}
 
-	for (int i = 0; i < players.size(); ++i)
-	{
-		SMPlayer *player = players[i];
-		if (!SMUtil::toLower(player->getName()).compare(lname))
-			return player;
-	}
-	return NULL;
+SMPlayer *Server::getPlayerExact(const std::string &name) const
+{
+	return playerRegistry.getByName(name);
 }
 
 SMLocalPlayer *Server::getLocalPlayer() const
@@ -260,26 +310,43 @@ SMLocalPlayer *Server::getLocalPlayer() const
 
 void Server::addPlayer(SMPlayer *player)
 {
-	if (std::find(players.begin(), players.end(), player) == players.end())
-		players.push_back(player);
+	if (!playerRegistry.add(player, player->getHandle(), player->getHandle()->guid.g, player->getName()))
+		return;
+
+	players.push_back(player);
+	playerNames.add(player, player->getName());
+	commandMap->getCompleter()->addPlayer(player);
+
+	Player *handle = player->getHandle();
+	if (!player->isLocalPlayer() && handle->getRegion())
+		interestGrid.update(player, (int)handle->getRegion()->getDimensionId(), handle->pos.x, handle->pos.z);
 }
 
 void Server::removePlayer(SMPlayer *player)
 {
 	auto it = std::find(players.begin(), players.end(), player);
-	if (it != players.end())
-		players.erase(it);
+	if (it == players.end())
+		return;
+
+	players.erase(it);
+	playerRegistry.remove(player, player->getHandle(), player->getHandle()->guid.g, player->getName());
+
+	playerNames.remove(player, player->getName());
+	commandMap->getCompleter()->removePlayer(player);
+	interestGrid.remove(player);
+
+	if (!player->isLocalPlayer())
+		broadcastQueue->remove(player->getHandle()->guid);
 }
 
 SMPlayer *Server::getPlayer(Player *player) const
 {
-	for (int i = 0; i < players.size(); ++i)
-	{
-		SMPlayer *smPlayer = players[i];
-		if (smPlayer->getHandle() == player)
-			return smPlayer;
-	}
-	return NULL;
+	return playerRegistry.getByHandle(player);
+}
+
+SMPlayer *Server::getPlayer(const RakNet::RakNetGUID &guid) const
+{
+	return playerRegistry.getByGuid(guid.g);
 }
 
 void Server::removeEntity(Entity *entity)
@@ -312,42 +379,95 @@ void Server::kickPlayer(SMPlayer *player, const std::string &reason)
 
 void Server::broadcastMessage(const std::string &message)
 {
-	for (std::string m : SMUtil::split(message, '\n'))
-	{
-		if (m.empty())
-			continue;
-
-		TextPacket pk;
-		pk.type = TextPacket::TYPE_RAW;
-		pk.message = m;
-		getServer()->getPacketSender()->send(pk);
-	}
+	broadcastQueue->queueMessage(NULL, message);
 }
 
 void Server::broadcastTranslation(const std::string &message, const std::vector<std::string> &params)
 {
-	TextPacket pk;
-	pk.type = TextPacket::TYPE_TRANSLATION;
-	pk.message = message;
-	pk.params = params;
-	getServer()->getPacketSender()->send(pk);
+	broadcastQueue->queueTranslation(NULL, message, params);
 }
 
 void Server::broadcastTip(const std::string &message)
 {
-	TextPacket pk;
-	pk.type = TextPacket::TYPE_TIP;
-	pk.message = message;
-	getServer()->getPacketSender()->send(pk);
+	broadcastQueue->queueTip(NULL, message);
 }
 
 void Server::broadcastPopup(const std::string &message, const std::string &subtitle)
 {
-	TextPacket pk;
-	pk.type = TextPacket::TYPE_POPUP;
-	pk.source = message;
-	pk.message = subtitle;
-	getServer()->getPacketSender()->send(pk);
+	broadcastQueue->queuePopup(NULL, message, subtitle);
+}
+
+BroadcastQueue *Server::getBroadcastQueue() const
+{
+	return broadcastQueue;
+}
+
+void Server::broadcastPacket(const Packet &packet, const std::vector<SMPlayer *> &targets)
+{
+	SerializedPacket serialized(packet);
+	for (SMPlayer *player : targets)
+		player->sendPacket(serialized);
+}
+
+bool Server::relayMovement(SMPlayer *player, const Packet &packet)
+{
+	if (!raknet)
+		return false;
+
+	Player *handle = player->getHandle();
+
+	interestGrid.setRadius(getViewDistance() * 16.0f);
+	interestGrid.update(player, (int)handle->getRegion()->getDimensionId(), handle->pos.x, handle->pos.z);
+	interestGrid.getRecipients(player, relayTargets);
+
+	if (!relayTargets.empty())
+		broadcastPacket(packet, relayTargets);
+	return true;
+}
+
+MovementFilter *Server::getMovementFilter()
+{
+	return &movementFilter;
+}
+
+PacketRateLimiter *Server::getPacketLimiter()
+{
+	return &packetLimiter;
+}
+
+LoginQueue *Server::getLoginQueue()
+{
+	return &loginQueue;
+}
+
+ServerAnnouncer *Server::getAnnouncer()
+{
+	return &announcer;
+}
+
+SkinValidator *Server::getSkinValidator() const
+{
+	return skinValidator;
+}
+
+PlayerSaveQueue *Server::getPlayerSaveQueue() const
+{
+	return playerSaves;
+}
+
+AsyncCommandRunner *Server::getAsyncCommandRunner() const
+{
+	return asyncCommands;
+}
+
+Scheduler *Server::getScheduler() const
+{
+	return scheduler;
+}
+
+ThreadPool *Server::getThreadPool() const
+{
+	return threadPool;
 }
 
 int Server::getMaxPlayers() const
@@ -397,7 +517,7 @@ void Server::setPvP(bool value)
 
 bool Server::dispatchCommand(SMPlayer *player, const std::string &commandLine)
 {
-	if (!player->isLocalPlayer() && !isOp(player->getName()))
+	if (!player->isOp())
 	{
 		player->sendTranslation("§c%commands.generic.permission", {});
 		return false;
@@ -450,25 +570,21 @@ void Server::banIP(const std::string &address)
 	BanEntry *entry = new BanEntry(address);
 
 	banByIP->add(entry);
-	banByIP->save();
 }
 
-void Server::unbanIP(const std::string &address)
+bool Server::unbanIP(const std::string &address)
 {
-	banByIP->pardon(address);
-	banByIP->save();
+	return banByIP->pardon(address);
 }
 
 void Server::addWhitelist(const std::string &name)
 {
 	whitelist->add(name);
-	whitelist->save();
 }
 
 void Server::removeWhitelist(const std::string &name)
 {
 	whitelist->remove(name);
-	whitelist->save();
 }
 
 void Server::reloadWhitelist()
@@ -479,23 +595,21 @@ void Server::reloadWhitelist()
 void Server::addOp(const std::string &name)
 {
 	operators->add(SMUtil::toLower(name));
-	operators->save();
 }
 
 void Server::removeOp(const std::string &name)
 {
 	operators->remove(SMUtil::toLower(name));
-	operators->save();
 }
 
 bool Server::isWhitelisted(const std::string &name) const
 {
-	return !options->hasWhitelist() || operators->isExist(SMUtil::toLower(name)) || whitelist->isExist(SMUtil::toLower(name));
+	return !options->hasWhitelist() || operators->isExist(name) || whitelist->isExist(name);
 }
 
 bool Server::isOp(const std::string &name) const
 {
-	return operators->isExist(SMUtil::toLower(name));
+	return operators->isExist(name);
 }
 
 CommandMap *Server::getCommandMap() const
@@ -545,48 +659,35 @@ Minecraft *Server::getServer() const
 	return server;
 }
 
-bool Server::updateCheck()
+void Server::setRakNetInstance(RakNetInstance *raknet)
 {
-	std::string data;
-	CURL *curl = curl_easy_init();
-	if (!curl)
-		return false;
-
-	struct Writer
-	{
-		static size_t write(char *data, size_t size, size_t nmemb, std::string *writerData)
-		{
-			writerData->append(data, size * nmemb);
-			return size * nmemb;
-		}
-	};
+	this->raknet = raknet;
+}
 
-	curl_easy_setopt(curl, CURLOPT_URL, "https://rawgit.com/KsyMC/9e8670ccfaa9c8b1dfd4/raw/servermanager.json");
-	curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-	curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
-	curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &data);
-	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, Writer::write);
+RakNetInstance *Server::getRakNetInstance() const
+{
+	return raknet;
+}
 
-	CURLcode rc = curl_easy_perform(curl);
-	if (CURLE_OK != rc)
-		return false;
+void Server::updateCheck()
+{
+	updateChecker->start(options->getUpdateUrl(), serverDir + "update-cache.json");
+}
 
-	curl_easy_cleanup(curl);
+void Server::notifyUpdate()
+{
+	UpdateChecker::Result update;
+	if (!updateChecker->getResult(update) || update.versionCode == 0 || update.versionCode == VERSION_CODE)
+		return;
 
-	if (!data.empty())
+	if (update.versionCode > VERSION_CODE)
 	{
-		Json::Value root;
-		Json::Reader reader;
-		if (!reader.parse(data, root))
-			return false;
-
-		newVersion = root.get("version", "").asString("");
-		newVersionCode = root.get("version-code", 0).asInt(0);
-		for (Json::Value log : root["changelog"])
-			newChangelog.push_back(log.asString(""));
+		localPlayer->sendMessage("[SM] 새로운 버전이 있습니다 : v" + update.version + " Changelog:");
+		for (int i = 0; i < update.changelog.size(); i++)
+			localPlayer->sendMessage(" " + SMUtil::toString(i + 1) + ". " + update.changelog[i]);
 	}
-	return true;
+	else
+		localPlayer->sendMessage("[SM] 현재 개발 버전을 사용중입니다.");
 }
 
 void Server::setVanillaCommands()
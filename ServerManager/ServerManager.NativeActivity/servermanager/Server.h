@@ -4,8 +4,16 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <unordered_map>
 
 #include "BanList.h"
+#include "PlayerNameIndex.h"
+#include "PlayerRegistry.h"
+#include "InterestGrid.h"
+#include "network/MovementFilter.h"
+#include "network/PacketRateLimiter.h"
+#include "network/LoginQueue.h"
+#include "network/ServerAnnouncer.h"
 #include "entity/SMPlayer.h"
 #include "plugin/PluginLoadOrder.h"
 #include "minecraftpe/gamemode/GameType.h"
@@ -19,6 +27,17 @@ class SMPlayer;
 class CommandMap;
 class Level;
 class PluginManager;
+class PersistenceWorker;
+class UpdateChecker;
+class SkinValidator;
+class PlayerSaveQueue;
+class AsyncCommandRunner;
+class Scheduler;
+class ThreadPool;
+class BroadcastQueue;
+class SerializedPacket;
+class RakNetInstance;
+class Packet;
 class Minecraft;
 class LocalPlayer;
 class SMEntity;
@@ -28,34 +47,54 @@ class PluginCommand;
 class Player;
 class Entity;
 
+namespace RakNet
+{
+	struct RakNetGUID;
+}
+
 class Server
 {
 private:
 	bool started;
+	bool updateNotified;
 
 	std::string serverDir;
 	std::string pluginDir;
 
 	SMLevel *level;
 	Minecraft *server;
+	RakNetInstance *raknet;
 	SMOptions *options;
 
 	BanList *banByName;
 	BanList *banByIP;
 	SMList *operators;
 	SMList *whitelist;
+	ThreadPool *threadPool;
+	PersistenceWorker *persistence;
+	PlayerSaveQueue *playerSaves;
 
 	CommandMap *commandMap;
+	AsyncCommandRunner *asyncCommands;
+	Scheduler *scheduler;
 	PluginManager *pluginManager;
 
 	SMLocalPlayer *localPlayer;
 
-	std::string newVersion;
-	int newVersionCode;
-	std::vector<std::string> newChangelog;
+	UpdateChecker *updateChecker;
+	BroadcastQueue *broadcastQueue;
+	SkinValidator *skinValidator;
 
 	std::map<EntityUniqueID, SMEntity *> entityList;
 	std::vector<SMPlayer *> players;
+	PlayerRegistry playerRegistry;
+	PlayerNameIndex playerNames;
+	InterestGrid interestGrid;
+	std::vector<SMPlayer *> relayTargets;
+	MovementFilter movementFilter;
+	PacketRateLimiter packetLimiter;
+	LoginQueue loginQueue;
+	ServerAnnouncer announcer;
 
 public:
 	Server();
@@ -66,6 +105,9 @@ public:
 
 	void start(LocalPlayer *localPlayer, Level *level);
 	void stop();
+	void tick();
+
+	const std::string &getServerDir() const;
 
 	SMOptions *getOptions() const;
 	void saveOptions();
@@ -78,12 +120,14 @@ public:
 	const std::vector<SMPlayer *> &getOnlinePlayers() const;
 	SMPlayer *getPlayer(const std::string &name) const;
 	std::vector<SMPlayer *> matchPlayer(const std::string &partialName) const;
+	const std::vector<PlayerNameIndex::Entry> *getPlayerCandidates(const std::string &partialName) const;
 	SMPlayer *getPlayerExact(const std::string &name) const;
 	SMLocalPlayer *getLocalPlayer() const;
 
 	void addPlayer(SMPlayer *player);
 	void removePlayer(SMPlayer *player);
 	SMPlayer *getPlayer(Player *player) const;
+	SMPlayer *getPlayer(const RakNet::RakNetGUID &guid) const;
 
 	void removeEntity(Entity *entity);
 	SMEntity *getEntity(Entity *entity);
@@ -94,6 +138,18 @@ public:
 	void broadcastTranslation(const std::string &message, const std::vector<std::string> &params);
 	void broadcastTip(const std::string &message);
 	void broadcastPopup(const std::string &message, const std::string &subtitle = "");
+	BroadcastQueue *getBroadcastQueue() const;
+	void broadcastPacket(const Packet &packet, const std::vector<SMPlayer *> &targets);
+	bool relayMovement(SMPlayer *player, const Packet &packet);
+	MovementFilter *getMovementFilter();
+	PacketRateLimiter *getPacketLimiter();
+	LoginQueue *getLoginQueue();
+	ServerAnnouncer *getAnnouncer();
+	SkinValidator *getSkinValidator() const;
+	PlayerSaveQueue *getPlayerSaveQueue() const;
+	AsyncCommandRunner *getAsyncCommandRunner() const;
+	Scheduler *getScheduler() const;
+	ThreadPool *getThreadPool() const;
 
 	int getMaxPlayers() const;
 	int getPort() const;
@@ -116,7 +172,7 @@ public:
 	SMList *getOPList() const;
 
 	void banIP(const std::string &address);
-	void unbanIP(const std::string &address);
+	bool unbanIP(const std::string &address);
 
 	void addWhitelist(const std::string &name);
 	void removeWhitelist(const std::string &name);
@@ -136,8 +192,12 @@ public:
 
 	Minecraft *getServer() const;
 
+	void setRakNetInstance(RakNetInstance *raknet);
+	RakNetInstance *getRakNetInstance() const;
+
 private:
-	bool updateCheck();
+	void updateCheck();
+	void notifyUpdate();
 
 	void setVanillaCommands();
 
@@ -83,9 +83,9 @@ void ServerManager::banIP(const std::string &address)
 	server->banIP(address);
 }
 
-void ServerManager::unbanIP(const std::string &address)
+bool ServerManager::unbanIP(const std::string &address)
 {
-	server->unbanIP(address);
+	return server->unbanIP(address);
 }
 
 BanList *ServerManager::getBanList(BanList::Type type)
@@ -25,7 +25,7 @@ public:
 	static bool dispatchCommand(SMPlayer *sender, const std::string &commandLine);
 	static PluginCommand *getPluginCommand(const std::string &name);
 	static void banIP(const std::string &address);
-	static void unbanIP(const std::string &address);
+	static bool unbanIP(const std::string &address);
 	static BanList *getBanList(BanList::Type type);
 	static void setWhitelist(bool value);
 	static SMList *getWhitelist();
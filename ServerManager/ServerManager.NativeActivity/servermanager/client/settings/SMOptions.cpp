@@ -18,6 +18,25 @@ SMOptions::SMOptions(const std::string &file)
 
 	pvpMode = false;
 
+	listJournal = false;
+
+	updateUrl = "https://rawgit.com/KsyMC/9e8670ccfaa9c8b1dfd4/raw/servermanager.json";
+
+	moveMinDistance = 0.0625f;
+	moveMinRotation = 1.0f;
+	moveMaxPerTick = 2;
+
+	packetRate = 100.0f;
+	packetBurst = 200.0f;
+	packetKickThreshold = 100.0f;
+
+	loginsPerTick = 2;
+	loginsPerAddress = 5;
+
+	announceInterval = 0;
+
+	schedulerTickBudget = 0;
+
 	version = 0;
 	updateState = STATE_NOUPDATE;
 }
@@ -47,8 +66,7 @@ void SMOptions::load(const std::string &path)
 
 		if(s.size() > 2)
 		{
-			s.erase(s.begin());
-			for(int i = 0; i < s.size(); i++)
+			for(int i = 2; i < s.size(); i++)
 				value += ":" + s[i];
 		}
 
@@ -64,6 +82,37 @@ void SMOptions::load(const std::string &path)
 			whitelist = (bool) SMUtil::toInt(value);
 		else if(!key.compare("pvp"))
 			pvpMode = (bool) SMUtil::toInt(value);
+		else if(!key.compare("list-journal"))
+			listJournal = (bool) SMUtil::toInt(value);
+		else if(!key.compare("update-url"))
+			updateUrl = value;
+		else if(!key.compare("move-min-distance"))
+			moveMinDistance = SMUtil::toFloat(value);
+		else if(!key.compare("move-min-rotation"))
+			moveMinRotation = SMUtil::toFloat(value);
+		else if(!key.compare("move-max-per-tick"))
+			moveMaxPerTick = SMUtil::toInt(value);
+		else if(!key.compare("packet-rate"))
+			packetRate = SMUtil::toFloat(value);
+		else if(!key.compare("packet-burst"))
+			packetBurst = SMUtil::toFloat(value);
+		else if(!key.compare("packet-kick-threshold"))
+			packetKickThreshold = SMUtil::toFloat(value);
+		else if(!key.compare("logins-per-tick"))
+			loginsPerTick = SMUtil::toInt(value);
+		else if(!key.compare("logins-per-address"))
+			loginsPerAddress = SMUtil::toInt(value);
+		else if(!key.compare("announce-interval"))
+			announceInterval = SMUtil::toInt(value);
+		else if(!key.compare("scheduler-tick-budget"))
+			schedulerTickBudget = SMUtil::toInt(value);
+		else if(!key.compare(0, 13, "packet-limit-"))
+		{
+			// packet-limit-<id>:<rate>/<burst>
+			std::vector<std::string> budget = SMUtil::split(value, '/');
+			if(budget.size() == 2)
+				setPacketLimit(SMUtil::toInt(key.substr(13)), SMUtil::toFloat(budget[0]), SMUtil::toFloat(budget[1]));
+		}
 		else if(!key.compare("version"))
 			version = (char) SMUtil::toInt(value);
 	}
@@ -82,6 +131,20 @@ void SMOptions::save()
 	ofs << "view-distance:" << viewDistance << std::endl;
 	ofs << "white-list:" << whitelist << std::endl;
 	ofs << "pvp:" << pvpMode << std::endl;
+	ofs << "list-journal:" << listJournal << std::endl;
+	ofs << "update-url:" << updateUrl << std::endl;
+	ofs << "move-min-distance:" << moveMinDistance << std::endl;
+	ofs << "move-min-rotation:" << moveMinRotation << std::endl;
+	ofs << "move-max-per-tick:" << moveMaxPerTick << std::endl;
+	ofs << "packet-rate:" << packetRate << std::endl;
+	ofs << "packet-burst:" << packetBurst << std::endl;
+	ofs << "packet-kick-threshold:" << packetKickThreshold << std::endl;
+	ofs << "logins-per-tick:" << loginsPerTick << std::endl;
+	ofs << "logins-per-address:" << loginsPerAddress << std::endl;
+	ofs << "announce-interval:" << announceInterval << std::endl;
+	ofs << "scheduler-tick-budget:" << schedulerTickBudget << std::endl;
+	for(auto &it : packetLimits)
+		ofs << "packet-limit-" << it.first << ":" << it.second.first << "/" << it.second.second << std::endl;
 	ofs << "version:" << VERSION_CODE << std::endl;
 	ofs.close();
 }
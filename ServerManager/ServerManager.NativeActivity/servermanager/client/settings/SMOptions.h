@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <map>
+#include <utility>
 
 class SMOptions
 {
@@ -13,6 +15,19 @@ private:
 	int viewDistance;
 	bool whitelist;
 	bool pvpMode;
+	bool listJournal;
+	std::string updateUrl;
+	float moveMinDistance;
+	float moveMinRotation;
+	int moveMaxPerTick;
+	float packetRate;
+	float packetBurst;
+	float packetKickThreshold;
+	std::map<int, std::pair<float, float>> packetLimits;
+	int loginsPerTick;
+	int loginsPerAddress;
+	int announceInterval;
+	int schedulerTickBudget;
 
 	enum UpdateState
 	{
@@ -38,6 +53,19 @@ public:
 	int getViewDistance() const { return viewDistance; }
 	bool hasWhitelist() const { return whitelist; }
 	bool getPvP() const { return pvpMode; }
+	bool useListJournal() const { return listJournal; }
+	std::string getUpdateUrl() const { return updateUrl; }
+	float getMoveMinDistance() const { return moveMinDistance; }
+	float getMoveMinRotation() const { return moveMinRotation; }
+	int getMoveMaxPerTick() const { return moveMaxPerTick; }
+	float getPacketRate() const { return packetRate; }
+	float getPacketBurst() const { return packetBurst; }
+	float getPacketKickThreshold() const { return packetKickThreshold; }
+	const std::map<int, std::pair<float, float>> &getPacketLimits() const { return packetLimits; }
+	int getLoginsPerTick() const { return loginsPerTick; }
+	int getLoginsPerAddress() const { return loginsPerAddress; }
+	int getAnnounceInterval() const { return announceInterval; }
+	int getSchedulerTickBudget() const { return schedulerTickBudget; }
 
 	void setServerName(const std::string &value) { serverName = value; }
 	void setServerPort(unsigned short value) { serverPort = value; }
@@ -45,6 +73,19 @@ public:
 	void setViewDistance(int value) { viewDistance = value; }
 	void setWhitelist(bool value) { whitelist = value; }
 	void setPvP(bool value) { pvpMode = value; }
+	void setListJournal(bool value) { listJournal = value; }
+	void setUpdateUrl(const std::string &value) { updateUrl = value; }
+	void setMoveMinDistance(float value) { moveMinDistance = value; }
+	void setMoveMinRotation(float value) { moveMinRotation = value; }
+	void setMoveMaxPerTick(int value) { moveMaxPerTick = value; }
+	void setPacketRate(float value) { packetRate = value; }
+	void setPacketBurst(float value) { packetBurst = value; }
+	void setPacketKickThreshold(float value) { packetKickThreshold = value; }
+	void setPacketLimit(int packetId, float rate, float burst) { packetLimits[packetId] = std::make_pair(rate, burst); }
+	void setLoginsPerTick(int value) { loginsPerTick = value; }
+	void setLoginsPerAddress(int value) { loginsPerAddress = value; }
+	void setAnnounceInterval(int value) { announceInterval = value; }
+	void setSchedulerTickBudget(int value) { schedulerTickBudget = value; }
 
 	char getOldVersion() const { return version; };
 	int getUpdateState() const { return updateState; }
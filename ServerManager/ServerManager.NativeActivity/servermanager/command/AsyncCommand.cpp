@@ -0,0 +1,72 @@
+#include "AsyncCommand.h"
+#include "../ServerManager.h"
+#include "../entity/SMPlayer.h"
+#include "../entity/SMLocalPlayer.h"
+#include "minecraftpe/entity/player/Player.h"
+
+AsyncCommand::AsyncCommand(PluginCommand *command, SMPlayer *sender, const std::string &label, const std::vector<std::string> &args)
+{
+	this->command = command;
+	this->label = label;
+	this->args = args;
+
+	senderName = sender->getName();
+	localSender = sender->isLocalPlayer();
+	if(!localSender)
+		senderGuid = sender->getHandle()->guid;
+
+	success = false;
+}
+
+PluginCommand *AsyncCommand::getCommand() const
+{
+	return command;
+}
+
+const std::string &AsyncCommand::getLabel() const
+{
+	return label;
+}
+
+const std::vector<std::string> &AsyncCommand::getArgs() const
+{
+	return args;
+}
+
+const std::string &AsyncCommand::getSenderName() const
+{
+	return senderName;
+}
+
+void AsyncCommand::sendMessage(const std::string &message)
+{
+	messages.push_back(message);
+}
+
+const std::vector<std::string> &AsyncCommand::getMessages() const
+{
+	return messages;
+}
+
+bool AsyncCommand::isSuccess() const
+{
+	return success;
+}
+
+void AsyncCommand::setSuccess(bool success)
+{
+	this->success = success;
+}
+
+SMPlayer *AsyncCommand::getSender() const
+{
+	if(localSender)
+		return ServerManager::getLocalPlayer();
+
+	// the connection may have been handed to somebody else since
+	SMPlayer *player = ServerManager::getServer()->getPlayer(senderGuid);
+	if(!player || player->getName() != senderName)
+		return NULL;
+
+	return player;
+}
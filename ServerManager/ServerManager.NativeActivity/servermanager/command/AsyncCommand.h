@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "raknet/RakNetTypes.h"
+
+class SMPlayer;
+class PluginCommand;
+
+// a plugin command on its way through the worker pool, it remembers who sent it instead of holding on to the player
+class AsyncCommand
+{
+private:
+	PluginCommand *command;
+	std::string label;
+	std::vector<std::string> args;
+
+	std::string senderName;
+	RakNet::RakNetGUID senderGuid;
+	bool localSender;
+
+	std::vector<std::string> messages;
+	bool success;
+
+public:
+	AsyncCommand(PluginCommand *command, SMPlayer *sender, const std::string &label, const std::vector<std::string> &args);
+
+	PluginCommand *getCommand() const;
+	const std::string &getLabel() const;
+	const std::vector<std::string> &getArgs() const;
+	const std::string &getSenderName() const;
+
+	// held until the command is back on the main thread
+	void sendMessage(const std::string &message);
+	const std::vector<std::string> &getMessages() const;
+
+	bool isSuccess() const;
+	void setSuccess(bool success);
+
+	// main thread only, NULL once the sender has left
+	SMPlayer *getSender() const;
+};
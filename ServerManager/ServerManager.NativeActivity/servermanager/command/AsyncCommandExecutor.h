@@ -0,0 +1,15 @@
+#pragma once
+
+class SMPlayer;
+class AsyncCommand;
+
+class AsyncCommandExecutor
+{
+public:
+	virtual ~AsyncCommandExecutor() {};
+
+	// runs on a worker thread, it must not touch the game or the sender, replies go through command.sendMessage
+	virtual bool onAsyncCommand(AsyncCommand &command) = 0;
+	// runs on the main thread once the worker is done, sender is NULL if they left in the meantime
+	virtual void onAsyncCommandComplete(SMPlayer * /*sender*/, AsyncCommand & /*command*/) {};
+};
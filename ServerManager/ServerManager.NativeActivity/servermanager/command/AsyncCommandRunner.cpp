@@ -0,0 +1,105 @@
+#include <algorithm>
+
+#include "AsyncCommandRunner.h"
+#include "AsyncCommand.h"
+#include "AsyncCommandExecutor.h"
+#include "PluginCommand.h"
+#include "../entity/SMPlayer.h"
+#include "../plugin/Plugin.h"
+#include "../util/ThreadPool.h"
+
+AsyncCommandRunner::AsyncCommandRunner(ThreadPool *pool)
+{
+	this->pool = pool;
+}
+
+void AsyncCommandRunner::submit(Plugin *plugin, AsyncCommandExecutor *executor, AsyncCommand *command)
+{
+	std::shared_ptr<Job> job = std::make_shared<Job>();
+	job->plugin = plugin;
+	job->executor = executor;
+	job->command.reset(command);
+	job->cancelled = false;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending.push_back(job);
+	}
+	pool->submit([this, job] { run(job); });
+}
+
+void AsyncCommandRunner::cancel(Plugin *plugin)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+
+	// jobs still waiting in the pool see the flag and never call into the plugin
+	for(std::shared_ptr<Job> &job : pending)
+	{
+		if(job->plugin == plugin)
+			job->cancelled = true;
+	}
+
+	idle.wait(lock, [this, plugin] {
+		return std::find(running.begin(), running.end(), plugin) == running.end();
+	});
+
+	finished.erase(std::remove_if(finished.begin(), finished.end(), [plugin](const std::shared_ptr<Job> &job) {
+		return job->plugin == plugin;
+	}), finished.end());
+}
+
+int AsyncCommandRunner::process()
+{
+	std::vector<std::shared_ptr<Job>> done;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(finished.empty())
+			return 0;
+
+		done.swap(finished);
+	}
+
+	for(std::shared_ptr<Job> &job : done)
+	{
+		if(!job->plugin->isEnabled())
+			continue;
+
+		AsyncCommand &command = *job->command;
+		SMPlayer *sender = command.getSender();
+		if(sender)
+		{
+			for(const std::string &message : command.getMessages())
+				sender->sendMessage(message);
+
+			if(!command.isSuccess())
+				command.getCommand()->sendUsage(sender, command.getLabel());
+		}
+		job->executor->onAsyncCommandComplete(sender, command);
+	}
+	return done.size();
+}
+
+size_t AsyncCommandRunner::getQueued() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return pending.size();
+}
+
+void AsyncCommandRunner::run(const std::shared_ptr<Job> &job)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending.erase(std::find(pending.begin(), pending.end(), job));
+		if(job->cancelled)
+			return;
+
+		running.push_back(job->plugin);
+	}
+
+	job->command->setSuccess(job->executor->onAsyncCommand(*job->command));
+
+	std::lock_guard<std::mutex> lock(mutex);
+	running.erase(std::find(running.begin(), running.end(), job->plugin));
+	finished.push_back(job);
+	idle.notify_all();
+}
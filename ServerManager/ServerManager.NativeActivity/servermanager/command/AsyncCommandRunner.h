@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+class Plugin;
+class ThreadPool;
+class AsyncCommand;
+class AsyncCommandExecutor;
+
+// runs async plugin commands on the server's thread pool and hands the results back to Server::tick
+class AsyncCommandRunner
+{
+private:
+	struct Job
+	{
+		Plugin *plugin;
+		AsyncCommandExecutor *executor;
+		std::unique_ptr<AsyncCommand> command;
+		bool cancelled;
+	};
+
+	ThreadPool *pool;
+
+	mutable std::mutex mutex;
+	std::condition_variable idle;
+
+	std::vector<std::shared_ptr<Job>> pending;
+	std::vector<std::shared_ptr<Job>> finished;
+	std::vector<Plugin *> running;
+
+public:
+	AsyncCommandRunner(ThreadPool *pool);
+
+	void submit(Plugin *plugin, AsyncCommandExecutor *executor, AsyncCommand *command);
+
+	// drops everything the plugin still has queued and waits for its running commands, results are discarded
+	void cancel(Plugin *plugin);
+
+	// main thread, delivers the replies of finished commands
+	int process();
+
+	size_t getQueued() const;
+
+private:
+	void run(const std::shared_ptr<Job> &job);
+};
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cctype>
+
+#include "CommandCompleter.h"
+#include "Command.h"
+#include "../entity/SMPlayer.h"
+
+void CommandCompleter::addLabel(const std::string &label, Command *command, bool isAlias)
+{
+	Entry entry;
+	entry.key = fold(label);
+	entry.name = label;
+	entry.kind = isAlias ? ALIAS : COMMAND;
+	entry.command = command;
+	entry.player = NULL;
+	insert(labels, std::move(entry));
+}
+
+void CommandCompleter::addCommand(Command *command)
+{
+	std::string name = command->getName();
+	auto it = std::lower_bound(commands.begin(), commands.end(), name, [](Command *left, const std::string &right) {
+		return left->getName() < right;
+	});
+
+	if(it != commands.end() && (*it)->getName() == name)
+		*it = command;
+	else
+		commands.insert(it, command);
+}
+
+void CommandCompleter::clearCommands()
+{
+	labels.clear();
+	commands.clear();
+}
+
+void CommandCompleter::addPlayer(SMPlayer *player)
+{
+	Entry entry;
+	entry.name = player->getName();
+	entry.key = fold(entry.name);
+	entry.kind = PLAYER;
+	entry.command = NULL;
+	entry.player = player;
+	insert(players, std::move(entry));
+}
+
+void CommandCompleter::removePlayer(SMPlayer *player)
+{
+	std::string key = fold(player->getName());
+	auto it = std::lower_bound(players.begin(), players.end(), key, [](const Entry &left, const std::string &right) {
+		return left.key < right;
+	});
+
+	for(; it != players.end() && it->key == key; ++it)
+	{
+		if(it->player == player)
+		{
+			players.erase(it);
+			return;
+		}
+	}
+}
+
+void CommandCompleter::clearPlayers()
+{
+	players.clear();
+}
+
+std::vector<std::string> CommandCompleter::complete(const std::string &line, size_t limit) const
+{
+	std::string text = line;
+	if(!text.empty() && text[0] == '#')
+		text.erase(0, 1);
+
+	size_t space = text.rfind(' ');
+	std::string prefix = fold(space == std::string::npos ? text : text.substr(space + 1));
+
+	// the first word is a command label, anything after it is most likely a player
+	std::vector<const Entry *> matches;
+	collect(space == std::string::npos ? labels : players, prefix, matches);
+
+	std::stable_sort(matches.begin(), matches.end(), [&prefix](const Entry *left, const Entry *right) {
+		bool leftExact = left->key == prefix;
+		bool rightExact = right->key == prefix;
+		if(leftExact != rightExact)
+			return leftExact;
+		if(left->kind != right->kind)
+			return left->kind < right->kind;
+		return left->key.length() < right->key.length();
+	});
+
+	std::vector<std::string> suggestions;
+	for(const Entry *entry : matches)
+	{
+		if(limit > 0 && suggestions.size() >= limit)
+			break;
+
+		suggestions.push_back(entry->name);
+	}
+	return suggestions;
+}
+
+const std::vector<Command *> &CommandCompleter::getCommands() const
+{
+	return commands;
+}
+
+void CommandCompleter::insert(std::vector<Entry> &index, Entry &&entry)
+{
+	auto it = std::lower_bound(index.begin(), index.end(), entry.key, [](const Entry &left, const std::string &right) {
+		return left.key < right;
+	});
+
+	// a label registered again points at its newest command
+	if(entry.kind != PLAYER && it != index.end() && it->key == entry.key)
+	{
+		*it = std::move(entry);
+		return;
+	}
+	index.insert(it, std::move(entry));
+}
+
+void CommandCompleter::collect(const std::vector<Entry> &index, const std::string &prefix, std::vector<const Entry *> &matches)
+{
+	auto it = std::lower_bound(index.begin(), index.end(), prefix, [](const Entry &left, const std::string &right) {
+		return left.key < right;
+	});
+
+	for(; it != index.end() && !it->key.compare(0, prefix.length(), prefix); ++it)
+		matches.push_back(&*it);
+}
+
+std::string CommandCompleter::fold(const std::string &text)
+{
+	std::string folded = text;
+	for(char &c : folded)
+		c = ::tolower((unsigned char)c);
+	return folded;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+class Command;
+class SMPlayer;
+
+// sorted index of command labels, aliases and online player names, kept up to date as they come and go
+class CommandCompleter
+{
+public:
+	enum Kind
+	{
+		COMMAND,
+		ALIAS,
+		PLAYER
+	};
+
+	struct Entry
+	{
+		std::string key;
+		std::string name;
+		Kind kind;
+		Command *command;
+		SMPlayer *player;
+	};
+
+private:
+	std::vector<Entry> labels;
+	std::vector<Entry> players;
+	std::vector<Command *> commands;
+
+public:
+	void addLabel(const std::string &label, Command *command, bool isAlias);
+	void addCommand(Command *command);
+	void clearCommands();
+
+	void addPlayer(SMPlayer *player);
+	void removePlayer(SMPlayer *player);
+	void clearPlayers();
+
+	// suggestions for the word under the cursor at the end of a '#' line, best first
+	std::vector<std::string> complete(const std::string &line, size_t limit) const;
+
+	// every command once, sorted by name, for the help listing
+	const std::vector<Command *> &getCommands() const;
+
+private:
+	static void insert(std::vector<Entry> &index, Entry &&entry);
+	static void collect(const std::vector<Entry> &index, const std::string &prefix, std::vector<const Entry *> &matches);
+	static std::string fold(const std::string &text);
+};
@@ -0,0 +1,109 @@
+#include <cctype>
+
+#include "CommandLabelTable.h"
+
+CommandLabelTable::CommandLabelTable()
+{
+	count = 0;
+}
+
+void CommandLabelTable::set(const std::string &label, Command *command)
+{
+	// kept at most half full so probe runs stay short
+	if((count + 1) * 2 > slots.size())
+		grow();
+
+	unsigned int hash = hashFolded(label.c_str(), label.length());
+	size_t index = findSlot(hash, label.c_str(), label.length());
+
+	Slot &slot = slots[index];
+	if(!slot.command)
+	{
+		slot.hash = hash;
+		slot.label = label;
+		for(char &c : slot.label)
+			c = ::tolower((unsigned char)c);
+		++count;
+	}
+	slot.command = command;
+}
+
+Command *CommandLabelTable::find(const char *label, size_t length) const
+{
+	if(slots.empty())
+		return NULL;
+
+	return slots[findSlot(hashFolded(label, length), label, length)].command;
+}
+
+Command *CommandLabelTable::find(const std::string &label) const
+{
+	return find(label.c_str(), label.length());
+}
+
+void CommandLabelTable::clear()
+{
+	slots.clear();
+	count = 0;
+}
+
+size_t CommandLabelTable::size() const
+{
+	return count;
+}
+
+void CommandLabelTable::grow()
+{
+	std::vector<Slot> old;
+	old.swap(slots);
+
+	Slot empty;
+	empty.hash = 0;
+	empty.command = NULL;
+	slots.resize(old.empty() ? 64 : old.size() * 2, empty);
+
+	for(Slot &slot : old)
+	{
+		if(slot.command)
+			slots[findSlot(slot.hash, slot.label.c_str(), slot.label.length())] = std::move(slot);
+	}
+}
+
+size_t CommandLabelTable::findSlot(unsigned int hash, const char *label, size_t length) const
+{
+	// the capacity is a power of two, slots are never removed one by one so an empty slot ends the probe
+	size_t mask = slots.size() - 1;
+	size_t index = hash & mask;
+	while(slots[index].command)
+	{
+		if(slots[index].hash == hash && equalsFolded(slots[index].label, label, length))
+			break;
+
+		index = (index + 1) & mask;
+	}
+	return index;
+}
+
+unsigned int CommandLabelTable::hashFolded(const char *label, size_t length)
+{
+	unsigned int hash = 2166136261u;
+	for(size_t i = 0; i < length; ++i)
+	{
+		hash ^= (unsigned char)::tolower((unsigned char)label[i]);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+bool CommandLabelTable::equalsFolded(const std::string &label, const char *other, size_t length)
+{
+	if(label.length() != length)
+		return false;
+
+	for(size_t i = 0; i < length; ++i)
+	{
+		if(label[i] != ::tolower((unsigned char)other[i]))
+			return false;
+	}
+	return true;
+}
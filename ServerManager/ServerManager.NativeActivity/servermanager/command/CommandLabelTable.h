@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+class Command;
+
+// open addressing table from lowercased labels (and prefix:label fallbacks) to commands, looked up without building a key
+class CommandLabelTable
+{
+private:
+	struct Slot
+	{
+		unsigned int hash;
+		std::string label;
+		Command *command;
+	};
+
+	std::vector<Slot> slots;
+	size_t count;
+
+public:
+	CommandLabelTable();
+
+	void set(const std::string &label, Command *command);
+	Command *find(const char *label, size_t length) const;
+	Command *find(const std::string &label) const;
+	void clear();
+
+	size_t size() const;
+
+private:
+	void grow();
+	size_t findSlot(unsigned int hash, const char *label, size_t length) const;
+
+	static unsigned int hashFolded(const char *label, size_t length);
+	static bool equalsFolded(const std::string &label, const char *other, size_t length);
+};
@@ -0,0 +1,38 @@
+#include <cctype>
+
+#include "CommandLine.h"
+
+std::string CommandLine::Token::toString() const
+{
+	return std::string(data, length);
+}
+
+std::string CommandLine::Token::toLower() const
+{
+	std::string lower(data, length);
+	for(char &c : lower)
+		c = ::tolower((unsigned char)c);
+	return lower;
+}
+
+void CommandLine::tokenize(const std::string &line, std::vector<Token> &tokens)
+{
+	tokens.clear();
+
+	const char *begin = line.data();
+	const char *end = begin + line.length();
+	while(begin != end)
+	{
+		const char *delim = begin;
+		while(delim != end && *delim != ' ')
+			++delim;
+
+		Token token;
+		token.data = begin;
+		token.length = delim - begin;
+		tokens.push_back(token);
+
+		// a trailing space does not start another, empty token
+		begin = delim == end ? end : delim + 1;
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// splits a command line into spans over the original string, nothing is copied until a caller asks for it
+class CommandLine
+{
+public:
+	struct Token
+	{
+		const char *data;
+		size_t length;
+
+		std::string toString() const;
+		std::string toLower() const;
+	};
+
+	// same pieces as SMUtil::split(line, ' '), the vector keeps its capacity between calls
+	static void tokenize(const std::string &line, std::vector<Token> &tokens);
+};
@@ -18,6 +18,8 @@
 #include "defaults/TeleportCommand.h"
 #include "defaults/MeCommand.h"
 #include "defaults/KillCommand.h"
+#include "defaults/TimingsCommand.h"
+#include "defaults/StatusCommand.h"
 #include "../util/SMUtil.h"
 
 CommandMap::CommandMap()
@@ -54,6 +56,8 @@ void CommandMap::setDefaultCommands()
 	registerCommand("servermanager", new TeleportCommand);
 	registerCommand("servermanager", new MeCommand);
 	registerCommand("servermanager", new KillCommand);
+	registerCommand("servermanager", new TimingsCommand);
+	registerCommand("servermanager", new StatusCommand);
 }
 
 void CommandMap::setFallbackCommands()
@@ -81,6 +85,7 @@ bool CommandMap::registerCommand(const std::string &label, const std::string &fa
 	std::string newFallbackPrefix = SMUtil::toLower(SMUtil::trim(fallbackPrefix));
 
 	bool registered = registerCommand(newLabel, command, false, newFallbackPrefix);
+	completer.addCommand(command);
 
 	std::vector<std::string> aliases = command->getAliases();
 	for (auto it = aliases.begin(); it != aliases.end(); ++it)
@@ -99,11 +104,14 @@ bool CommandMap::registerCommand(const std::string &label, const std::string &fa
 
 bool CommandMap::registerCommand(const std::string &label, Command *command, bool isAlias, const std::string &fallbackPrefix)
 {
-	knownCommands[fallbackPrefix + ":" + label] = command;
-	if ((command->isVanillaCommand() || isAlias) && knownCommands.find(label) != knownCommands.end())
+	std::string fallbackLabel = fallbackPrefix + ":" + label;
+	knownCommands[fallbackLabel] = command;
+	labels.set(fallbackLabel, command);
+	bool known = labels.find(label) != NULL;
+	if ((command->isVanillaCommand() || isAlias) && known)
 		return false;
 
-	if (knownCommands.find(label) != knownCommands.end() && !command->getLabel().compare(label))
+	if (known && !command->getLabel().compare(label))
 		return false;
 
 	if (!isAlias)
@@ -112,23 +120,29 @@ bool CommandMap::registerCommand(const std::string &label, Command *command, boo
 		command->setLabel(label);
 	}
 	knownCommands[label] = command;
+	labels.set(label, command);
+	completer.addLabel(label, command, isAlias);
 
 	return true;
 }
 
 bool CommandMap::dispatch(SMPlayer *sender, const std::string &cmdLine)
 {
-	std::vector<std::string> args = SMUtil::split(cmdLine, ' ');
-	if (args.empty())
+	CommandLine::tokenize(cmdLine, tokens);
+	if (tokens.empty())
 		return false;
 
-	std::string sentCommandLabel = SMUtil::toLower(args.front());
-	Command *target = getCommand(sentCommandLabel);
-
+	Command *target = labels.find(tokens[0].data, tokens[0].length);
 	if (!target)
 		return false;
 
-	args.erase(args.begin());
+	// only a command that exists gets its label and arguments copied out of the line
+	std::string sentCommandLabel = tokens[0].toLower();
+	std::vector<std::string> args;
+	args.reserve(tokens.size() - 1);
+	for (size_t i = 1; i < tokens.size(); ++i)
+		args.push_back(tokens[i].toString());
+
 	target->execute(sender, sentCommandLabel, args);
 
 	return true;
@@ -143,20 +157,23 @@ void CommandMap::clearCommands()
 		delete cmd;
 
 	knownCommands.clear();
+	labels.clear();
+	completer.clearCommands();
 	commands.clear();
 	setDefaultCommands();
 }
 
 Command *CommandMap::getCommand(const std::string &name)
 {
-	std::string lname = SMUtil::toLower(name);
-	if (knownCommands.find(lname) != knownCommands.end())
-		return knownCommands[lname];
-
-	return NULL;
+	return labels.find(name);
 }
 
 const std::map<std::string, Command *> &CommandMap::getCommands() const
 {
 	return knownCommands;
 }
+
+CommandCompleter *CommandMap::getCompleter()
+{
+	return &completer;
+}
@@ -4,6 +4,10 @@
 #include <vector>
 #include <map>
 
+#include "CommandLine.h"
+#include "CommandLabelTable.h"
+#include "CommandCompleter.h"
+
 class Command;
 class SMPlayer;
 
@@ -12,6 +16,9 @@ class CommandMap
 private:
 	std::vector<Command *> commands;
 	std::map<std::string, Command *> knownCommands;
+	CommandLabelTable labels;
+	std::vector<CommandLine::Token> tokens;
+	CommandCompleter completer;
 
 public:
 	CommandMap();
@@ -31,4 +38,5 @@ public:
 
 	Command *getCommand(const std::string &name);
 	const std::map<std::string, Command *> &getCommands() const;
+	CommandCompleter *getCompleter();
 };
@@ -1,6 +1,9 @@
 #include "PluginCommand.h"
 #include "../entity/SMPlayer.h"
 #include "CommandExecutor.h"
+#include "AsyncCommand.h"
+#include "AsyncCommandRunner.h"
+#include "../Server.h"
 #include "../plugin/Plugin.h"
 #include "../util/SMUtil.h"
 
@@ -8,7 +11,9 @@ PluginCommand::PluginCommand(const std::string &name, Plugin *owner)
 	: Command(name)
 {
 	this->executor = owner;
+	this->asyncExecutor = owner;
 	this->owningPlugin = owner;
+	this->async = false;
 }
 
 bool PluginCommand::execute(SMPlayer *sender, std::string &label, std::vector<std::string> &args)
@@ -18,21 +23,17 @@ bool PluginCommand::execute(SMPlayer *sender, std::string &label, std::vector<st
 	if(!owningPlugin->isEnabled())
 		return false;
 
-	success = executor->onCommand(sender, this, label, args);
-
-	if(!success && usageMessage.length() > 0)
+	if(async)
 	{
-		std::string newUsage = usageMessage;
-		if(newUsage.find("<command>") != std::string::npos)
-		{
-			std::string findString = "<command>";
-			newUsage.replace(newUsage.find(findString), findString.length(), label);
-		}
-
-		for(std::string line : SMUtil::split(newUsage, '\n'))
-			sender->sendMessage(line);
+		owningPlugin->getServer()->getAsyncCommandRunner()->submit(owningPlugin, asyncExecutor, new AsyncCommand(this, sender, label, args));
+		return true;
 	}
 
+	success = executor->onCommand(sender, this, label, args);
+
+	if(!success)
+		sendUsage(sender, label);
+
 	return success;
 }
 
@@ -51,6 +52,42 @@ CommandExecutor *PluginCommand::getExecutor() const
 	return executor;
 }
 
+void PluginCommand::setAsync(bool async)
+{
+	this->async = async;
+}
+
+bool PluginCommand::isAsync() const
+{
+	return async;
+}
+
+void PluginCommand::setAsyncExecutor(AsyncCommandExecutor *executor)
+{
+	this->asyncExecutor = !executor ? owningPlugin : executor;
+}
+
+AsyncCommandExecutor *PluginCommand::getAsyncExecutor() const
+{
+	return asyncExecutor;
+}
+
+void PluginCommand::sendUsage(SMPlayer *sender, const std::string &label) const
+{
+	if(usageMessage.empty())
+		return;
+
+	std::string newUsage = usageMessage;
+	if(newUsage.find("<command>") != std::string::npos)
+	{
+		std::string findString = "<command>";
+		newUsage.replace(newUsage.find(findString), findString.length(), label);
+	}
+
+	for(std::string line : SMUtil::split(newUsage, '\n'))
+		sender->sendMessage(line);
+}
+
 Plugin *PluginCommand::getPlugin() const
 {
 	return owningPlugin;
@@ -4,12 +4,15 @@
 #include "PluginIdentifiableCommand.h"
 
 class CommandExecutor;
+class AsyncCommandExecutor;
 
 class PluginCommand : public Command, public PluginIdentifiableCommand
 {
 private:
 	Plugin *owningPlugin;
 	CommandExecutor *executor;
+	AsyncCommandExecutor *asyncExecutor;
+	bool async;
 
 public:
 	PluginCommand(const std::string &name, Plugin *owner);
@@ -21,5 +24,14 @@ public:
 	void setExecutor(CommandExecutor *executor);
 	CommandExecutor *getExecutor() const;
 
+	// async commands run onAsyncCommand on a worker thread instead of onCommand
+	void setAsync(bool async);
+	bool isAsync() const;
+
+	void setAsyncExecutor(AsyncCommandExecutor *executor);
+	AsyncCommandExecutor *getAsyncExecutor() const;
+
+	void sendUsage(SMPlayer *sender, const std::string &label) const;
+
 	Plugin *getPlugin() const;
 };
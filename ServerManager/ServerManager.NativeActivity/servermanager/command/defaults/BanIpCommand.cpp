@@ -1,8 +1,7 @@
-#include <regex>
-
 #include "BanIpCommand.h"
 #include "../../ServerManager.h"
 #include "../../BanList.h"
+#include "../../IPRangeTree.h"
 #include "../../entity/SMPlayer.h"
 #include "../../util/SMUtil.h"
 
@@ -26,8 +25,8 @@ bool BanIpCommand::execute(SMPlayer *sender, std::string &label, std::vector<std
 	args.erase(args.begin());
 	std::string reason = SMUtil::trim(SMUtil::join(args, " "));
 
-	std::regex rx("\\b((25[0-5]|2[0-4][0-9]|[01]?[0-9][0-9]?)\\.){3}(25[0-5]|2[0-4][0-9]|[01]?[0-9][0-9]?)\\b");
-	if (std::regex_match(nameOrIP, rx))
+	IPRangeTree::Range range;
+	if (IPRangeTree::parse(nameOrIP, range))
 	{
 		Command::broadcastCommandTranslation(sender, "commands.banip.success", { nameOrIP });
 		processIPBan(nameOrIP, sender, reason);
@@ -51,13 +50,14 @@ bool BanIpCommand::execute(SMPlayer *sender, std::string &label, std::vector<std
 
 void BanIpCommand::processIPBan(const std::string &ip, SMPlayer *source, const std::string &reason)
 {
-	ServerManager::getBanList(BanList::IP)->addBan(ip, reason, source->getName());
+	BanList *banList = ServerManager::getBanList(BanList::IP);
+	banList->addBan(ip, reason, source->getName());
 
 	std::vector<SMPlayer *> players = ServerManager::getOnlinePlayers();
 	for (int i = 0; i < players.size(); ++i)
 	{
 		SMPlayer *player = players[i];
-		if (!ip.compare(player->getAddress()))
+		if (banList->matchAddress(player->getAddress()))
 			ServerManager::kickPlayer(player, "You have been IP banned.");
 	}
 }
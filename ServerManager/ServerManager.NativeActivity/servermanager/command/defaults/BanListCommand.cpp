@@ -27,7 +27,7 @@ bool BanListCommand::execute(SMPlayer *sender, std::string &label, std::vector<s
 	}
 
 	std::string message;
-	std::vector<BanEntry *> banList = ServerManager::getBanList(banType)->getBanEntries();
+	const std::vector<BanEntry *> &banList = ServerManager::getBanList(banType)->getBanEntries();
 
 	for(size_t i = 0; i < banList.size(); i++)
 	{
@@ -4,6 +4,7 @@
 #include "../../ServerManager.h"
 #include "../../entity/SMPlayer.h"
 #include "../CommandMap.h"
+#include "../CommandCompleter.h"
 #include "../../util/SMUtil.h"
 #include "minecraftpe/client/resources/I18n.h"
 
@@ -35,28 +36,12 @@ bool HelpCommand::execute(SMPlayer *sender, std::string &commandLabel, std::vect
 
 	if(command.empty())
 	{
-		struct comp
-		{
-			bool operator() (const std::string &left, const std::string &right) const
-			{
-				return left <right;
-			}
-		};
-
-		std::map<std::string, Command *, comp> commandList;
+		// already sorted by name, kept that way as commands are registered
+		const std::vector<Command *> &sortCommands = ServerManager::getServer()->getCommandMap()->getCompleter()->getCommands();
 
-		for(auto &key : ServerManager::getServer()->getCommandMap()->getCommands())
-		{
-			Command *command = key.second;
-			commandList[command->getName()] = command;
-		}
-		//int pages = (int)std::ceil((int)commandList.size() / (float)pageHeight);
+		//int pages = (int)std::ceil((int)sortCommands.size() / (float)pageHeight);
 		int pages = 1;
 
-		std::vector<Command *> sortCommands;
-		for(auto &key : commandList)
-			sortCommands.push_back(key.second);
-
 		pageNumber = std::min(pages, pageNumber);
 
 		sender->sendTranslation("commands.help.header", {SMUtil::toString(pageNumber), SMUtil::toString(pages)});
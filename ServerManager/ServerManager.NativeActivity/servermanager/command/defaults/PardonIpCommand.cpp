@@ -1,7 +1,6 @@
-#include <regex>
-
 #include "PardonIpCommand.h"
 #include "../../ServerManager.h"
+#include "../../IPRangeTree.h"
 #include "../../entity/SMPlayer.h"
 
 PardonIpCommand::PardonIpCommand()
@@ -19,14 +18,13 @@ bool PardonIpCommand::execute(SMPlayer *sender, std::string &label, std::vector<
 		return false;
 	}
 
-	std::regex rx("\\b((25[0-5]|2[0-4][0-9]|[01]?[0-9][0-9]?)\\.){3}(25[0-5]|2[0-4][0-9]|[01]?[0-9][0-9]?)\\b");
-	if(std::regex_match(args[0], rx))
-	{
-		ServerManager::unbanIP(args[0]);
-		Command::broadcastCommandTranslation(sender, "commands.unbanip.success", {args[0]});
-	}
-	else
+	IPRangeTree::Range range;
+	if(!IPRangeTree::parse(args[0], range))
 		sender->sendTranslation("commands.unbanip.invalid", {});
+	else if(!ServerManager::unbanIP(args[0]))
+		sender->sendMessage("§c" + args[0] + " is not banned");
+	else
+		Command::broadcastCommandTranslation(sender, "commands.unbanip.success", {args[0]});
 
 	return true;
 }
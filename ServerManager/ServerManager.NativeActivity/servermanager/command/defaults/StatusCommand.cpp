@@ -0,0 +1,71 @@
+#include "StatusCommand.h"
+#include "../../ServerManager.h"
+#include "../../entity/SMPlayer.h"
+#include "../../level/PlayerSaveQueue.h"
+#include "../../network/BroadcastQueue.h"
+#include "../../network/MovementFilter.h"
+#include "../../network/PacketRateLimiter.h"
+#include "../../util/SMUtil.h"
+#include "../../util/SkinValidator.h"
+#include "../../util/ThreadPool.h"
+
+StatusCommand::StatusCommand()
+	: VanillaCommand("status")
+{
+	description = "Reports the counters of the network, skin, save and worker subsystems";
+	usageMessage = "#status [reset]";
+}
+
+bool StatusCommand::execute(SMPlayer *sender, std::string &label, std::vector<std::string> &args)
+{
+	if(args.empty())
+	{
+		std::vector<std::string> summary;
+		getSummary(summary);
+
+		sender->sendMessage("§e--------- §fServer status §e---------");
+		sender->sendMessage(summary);
+		return true;
+	}
+
+	if((int)args.size() == 1 && !SMUtil::toLower(args[0]).compare("reset"))
+	{
+		// the other counters are totals since the server started
+		ServerManager::getServer()->getMovementFilter()->resetCounters();
+		ServerManager::getServer()->getPacketLimiter()->resetCounters();
+
+		sender->sendMessage("Movement and packet counters reset");
+		return true;
+	}
+
+	sender->sendTranslation("§c%commands.generic.usage", {usageMessage});
+	return false;
+}
+
+void StatusCommand::getSummary(std::vector<std::string> &summary)
+{
+	BroadcastQueue *broadcastQueue = ServerManager::getServer()->getBroadcastQueue();
+	summary.push_back(SMUtil::format("§2Text output§f: %llu packets sent, %llu saved by batching, %llu sent without re-encoding",
+		broadcastQueue->getSentPackets(), broadcastQueue->getSavedPackets(), broadcastQueue->getSharedEncodes()));
+
+	MovementFilter *movementFilter = ServerManager::getServer()->getMovementFilter();
+	summary.push_back(SMUtil::format("§2Movement§f: %llu processed, %llu dropped below threshold, %llu dropped over the per-tick cap",
+		movementFilter->getProcessedMoves(), movementFilter->getDroppedSmallMoves(), movementFilter->getDroppedRateMoves()));
+
+	const PacketRateLimiter::Counters &packets = ServerManager::getServer()->getPacketLimiter()->getCounters();
+	summary.push_back(SMUtil::format("§2Incoming packets§f: %llu allowed, %llu dropped, %llu connections kicked",
+		packets.allowed, packets.dropped, packets.kicked));
+
+	SkinValidator *skinValidator = ServerManager::getServer()->getSkinValidator();
+	summary.push_back(SMUtil::format("§2Skins§f: %llu checked off the game thread, %llu rejected, %llu KiB of copies saved",
+		skinValidator->getCheckedSkins(), skinValidator->getRejectedSkins(), skinValidator->getSavedBytes() / 1024));
+
+	ThreadPool::Stats stats = ServerManager::getServer()->getThreadPool()->getStats();
+	summary.push_back(SMUtil::format("§2Thread pool§f: %d workers, queued %u high / %u normal / %u low, %llu run, %llu stolen",
+		stats.workers, (unsigned)stats.queued[ThreadPool::HIGH], (unsigned)stats.queued[ThreadPool::NORMAL], (unsigned)stats.queued[ThreadPool::LOW],
+		stats.executed, stats.stolen));
+
+	PlayerSaveQueue *playerSaves = ServerManager::getServer()->getPlayerSaveQueue();
+	summary.push_back(SMUtil::format("§2Player saves§f: %llu queued, %llu merged, %llu written in %llu batches, %u waiting",
+		playerSaves->getQueuedSaves(), playerSaves->getMergedSaves(), playerSaves->getWrittenSaves(), playerSaves->getBatches(), (unsigned)playerSaves->size()));
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "VanillaCommand.h"
+
+class StatusCommand : public VanillaCommand
+{
+public:
+	StatusCommand();
+
+	bool execute(SMPlayer *sender, std::string &label, std::vector<std::string> &args);
+
+private:
+	static void getSummary(std::vector<std::string> &summary);
+};
@@ -0,0 +1,151 @@
+#include <fstream>
+#include <map>
+
+#include "TimingsCommand.h"
+#include "../../ServerManager.h"
+#include "../../entity/SMPlayer.h"
+#include "../../event/HandlerList.h"
+#include "../../plugin/Plugin.h"
+#include "../../plugin/RegisteredListener.h"
+#include "../../plugin/ListenerTimings.h"
+#include "../../util/SMUtil.h"
+
+TimingsCommand::TimingsCommand()
+	: VanillaCommand("timings")
+{
+	description = "Records and reports how long plugin event listeners take";
+	usageMessage = "#timings <on|off|reset|report>";
+}
+
+bool TimingsCommand::execute(SMPlayer *sender, std::string &label, std::vector<std::string> &args)
+{
+	if((int)args.size() != 1)
+	{
+		sender->sendTranslation("§c%commands.generic.usage", {usageMessage});
+		return false;
+	}
+
+	std::string mode = SMUtil::toLower(args[0]);
+	if(!mode.compare("on"))
+	{
+		ListenerTimings::setEnabled(true);
+		Command::broadcastCommandMessage(sender, "Enabled timings");
+		return true;
+	}
+	else if(!mode.compare("off"))
+	{
+		ListenerTimings::setEnabled(false);
+		Command::broadcastCommandMessage(sender, "Disabled timings");
+		return true;
+	}
+	else if(!mode.compare("reset"))
+	{
+		for(HandlerList *handlerList : HandlerList::getHandlerLists())
+			for(RegisteredListener *listener : handlerList->getRegisteredListeners())
+				listener->getTimings().reset();
+
+		sender->sendMessage("Timings reset");
+		return true;
+	}
+	else if(!mode.compare("report"))
+	{
+		std::string path = ServerManager::getServer()->getServerDir() + "timings.txt";
+		std::vector<std::string> summary;
+
+		if(!writeReport(path, summary))
+		{
+			sender->sendMessage("§cCould not write " + path);
+			return false;
+		}
+
+		sender->sendMessage("§e--------- §fTimings (per plugin) §e---------");
+		sender->sendMessage(summary);
+		sender->sendMessage("Timings written to " + path);
+		return true;
+	}
+
+	sender->sendTranslation("§c%commands.generic.usage", {usageMessage});
+	return false;
+}
+
+std::string TimingsCommand::getEventTypeName(EventType type)
+{
+	switch(type)
+	{
+	case EventType::PLUGIN_ENABLE: return "PluginEnableEvent";
+	case EventType::PLUGIN_DISABLE: return "PluginDisableEvent";
+	case EventType::PLAYER_PRE_LOGIN: return "PlayerPreLoginEvent";
+	case EventType::PLAYER_LOGIN: return "PlayerLoginEvent";
+	case EventType::PLAYER_JOIN: return "PlayerJoinEvent";
+	case EventType::PLAYER_QUIT: return "PlayerQuitEvent";
+	case EventType::PLAYER_DROP_ITEM: return "PlayerDropItemEvent";
+	case EventType::PLAYER_PICKUP_ITEM: return "PlayerPickupItemEvent";
+	case EventType::PLAYER_GAMEMODE_CHANGE: return "PlayerGameModeChangeEvent";
+	case EventType::PLAYER_BED_ENTER: return "PlayerBedEnterEvent";
+	case EventType::PLAYER_BED_LEAVE: return "PlayerBedLeaveEvent";
+	case EventType::PLAYER_MOVE: return "PlayerMoveEvent";
+	case EventType::PLAYER_TELEPORT: return "PlayerTeleportEvent";
+	case EventType::PLAYER_CHAT: return "PlayerChatEvent";
+	case EventType::PLAYER_COMMAND_PREPROCESS: return "PlayerCommandPreprocessEvent";
+	case EventType::PLAYER_INTERACT: return "PlayerInteractEvent";
+	case EventType::PLAYER_INTERACT_ENTITY: return "PlayerInteractEntityEvent";
+	case EventType::PLAYER_ANIMATION: return "PlayerAnimationEvent";
+	case EventType::SIGN_CHANGE: return "SignChangeEvent";
+	case EventType::BLOCK_BREAK: return "BlockBreakEvent";
+	case EventType::BLOCK_EXP: return "BlockExpEvent";
+	case EventType::BLOCK_PLACE: return "BlockPlaceEvent";
+	case EventType::CREEPER_POWER: return "CreeperPowerEvent";
+	}
+	return "UNKNOWN";
+}
+
+bool TimingsCommand::writeReport(const std::string &path, std::vector<std::string> &summary)
+{
+	std::ofstream ofs(path.c_str());
+	if(!ofs.is_open())
+		return false;
+
+	std::map<std::string, ListenerTimings::Snapshot> plugins;
+
+	ofs << "# plugin | event | count | total(ns) | avg(ns) | max(ns) | p99(ns)" << std::endl << std::endl;
+
+	for(HandlerList *handlerList : HandlerList::getHandlerLists())
+	{
+		for(RegisteredListener *listener : handlerList->getRegisteredListeners())
+		{
+			ListenerTimings::Snapshot snapshot = listener->getTimings().getSnapshot();
+			if(snapshot.count == 0)
+				continue;
+
+			std::string pluginName = listener->getPlugin()->getName();
+
+			ofs << pluginName << "|" << getEventTypeName(listener->getEventType()) << "|" << snapshot.count << "|"
+				<< snapshot.totalNanos << "|" << snapshot.totalNanos / snapshot.count << "|"
+				<< snapshot.maxNanos << "|" << snapshot.p99Nanos << std::endl;
+
+			auto it = plugins.find(pluginName);
+			if(it == plugins.end())
+				plugins[pluginName] = snapshot;
+			else
+			{
+				it->second.count += snapshot.count;
+				it->second.totalNanos += snapshot.totalNanos;
+				if(snapshot.maxNanos > it->second.maxNanos)
+					it->second.maxNanos = snapshot.maxNanos;
+				if(snapshot.p99Nanos > it->second.p99Nanos)
+					it->second.p99Nanos = snapshot.p99Nanos;
+			}
+		}
+	}
+	ofs.close();
+
+	for(auto &it : plugins)
+	{
+		summary.push_back(SMUtil::format("§2%s§f: %llu calls, total %llu us, max %llu us, p99 %llu us",
+			it.first.c_str(), it.second.count, it.second.totalNanos / 1000, it.second.maxNanos / 1000, it.second.p99Nanos / 1000));
+	}
+	if(summary.empty())
+		summary.push_back("No listener has been timed yet");
+
+	return true;
+}
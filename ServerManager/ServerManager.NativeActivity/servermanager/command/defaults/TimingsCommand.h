@@ -0,0 +1,16 @@
+#pragma once
+
+#include "VanillaCommand.h"
+#include "../../event/EventType.h"
+
+class TimingsCommand : public VanillaCommand
+{
+public:
+	TimingsCommand();
+
+	bool execute(SMPlayer *sender, std::string &label, std::vector<std::string> &args);
+
+private:
+	static std::string getEventTypeName(EventType type);
+	static bool writeReport(const std::string &path, std::vector<std::string> &summary);
+};
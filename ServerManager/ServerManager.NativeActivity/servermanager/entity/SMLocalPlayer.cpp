@@ -34,6 +34,11 @@ void SMLocalPlayer::sendTip(const std::string &message)
 	getHandle()->client->getGui()->showTipMessage(message);
 }
 
+void SMLocalPlayer::sendPacket(const SerializedPacket &packet)
+{
+	// the host plays on the server's own level, there is no connection to send to
+}
+
 bool SMLocalPlayer::isLocalPlayer() const
 {
 	return true;
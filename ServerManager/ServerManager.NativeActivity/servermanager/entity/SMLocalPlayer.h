@@ -14,6 +14,7 @@ public:
 	void sendTranslation(const std::string &message, const std::vector<std::string> &params);
 	void sendPopup(const std::string &message, const std::string &subtitle = "");
 	void sendTip(const std::string &message);
+	void sendPacket(const SerializedPacket &packet);
 
 	bool isLocalPlayer() const;
 
@@ -4,13 +4,14 @@
 #include "../BanEntry.h"
 #include "../level/SMLevel.h"
 #include "../level/SMBlockSource.h"
+#include "../network/BroadcastQueue.h"
+#include "../network/SerializedPacket.h"
 #include "../event/player/PlayerGameModeChangeEvent.h"
 #include "../plugin/PluginManager.h"
 #include "../util/SMUtil.h"
 #include "minecraftpe/client/resources/I18n.h"
 #include "minecraftpe/entity/player/Player.h"
 #include "minecraftpe/network/PacketSender.h"
-#include "minecraftpe/network/protocol/TextPacket.h"
 #include "minecraftpe/network/protocol/MovePlayerPacket.h"
 #include "minecraftpe/level/Level.h"
 #include "minecraftpe/level/BlockSource.h"
@@ -36,16 +37,7 @@ SMPlayer::~SMPlayer()
 
 void SMPlayer::sendRawMessage(const std::string &message)
 {
-	for(std::string m : SMUtil::split(message, '\n'))
-	{
-		if(!m.empty())
-		{
-			TextPacket pk;
-			pk.type = TextPacket::TYPE_RAW;
-			pk.message = m;
-			getPacketSender()->send(getHandle()->guid, pk);
-		}
-	}
+	server->getBroadcastQueue()->queueMessage(&getHandle()->guid, message);
 }
 
 void SMPlayer::sendMessage(const std::string &message)
@@ -61,28 +53,23 @@ void SMPlayer::sendMessage(const std::vector<std::string> messages)
 
 void SMPlayer::sendTranslation(const std::string &message, const std::vector<std::string> &params)
 {
-	TextPacket pk;
-	pk.type = TextPacket::TYPE_TRANSLATION;
-	pk.message = message;
-	pk.params = params;
-	getPacketSender()->send(getHandle()->guid, pk);
+	server->getBroadcastQueue()->queueTranslation(&getHandle()->guid, message, params);
 }
 
 void SMPlayer::sendPopup(const std::string &message, const std::string &subtitle)
 {
-	TextPacket pk;
-	pk.type = TextPacket::TYPE_POPUP;
-	pk.source = message;
-	pk.message = subtitle;
-	getPacketSender()->send(getHandle()->guid, pk);
+	server->getBroadcastQueue()->queuePopup(&getHandle()->guid, message, subtitle);
 }
 
 void SMPlayer::sendTip(const std::string &message)
 {
-	TextPacket pk;
-	pk.type = TextPacket::TYPE_TIP;
-	pk.message = message;
-	getPacketSender()->send(getHandle()->guid, pk);
+	server->getBroadcastQueue()->queueTip(&getHandle()->guid, message);
+}
+
+void SMPlayer::sendPacket(const SerializedPacket &packet)
+{
+	if(server->getRakNetInstance())
+		packet.send(server->getRakNetInstance(), getHandle()->guid);
 }
 
 bool SMPlayer::isLocalPlayer() const
@@ -92,7 +79,7 @@ bool SMPlayer::isLocalPlayer() const
 
 bool SMPlayer::isOp() const
 {
-	return server->isOp(getName());
+	return server->isOp(getHandle()->username);
 }
 
 void SMPlayer::setOp(bool value)
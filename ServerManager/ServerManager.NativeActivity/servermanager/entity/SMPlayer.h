@@ -3,9 +3,11 @@
 #include <vector>
 
 #include "SMMob.h"
+#include "../network/MovementFilter.h"
 #include "minecraftpe/gamemode/GameType.h"
 
 class PacketSender;
+class SerializedPacket;
 class Player;
 class Vec3;
 class Vec2;
@@ -21,6 +23,7 @@ public:
 	float lastYaw;
 	float lastPitch;
 	bool justTeleported;
+	MovementFilter::State movementState;
 
 protected:
 	bool blockLauncherClient;
@@ -41,6 +44,7 @@ public:
 	virtual void sendTranslation(const std::string &message, const std::vector<std::string> &params);
 	virtual void sendPopup(const std::string &message, const std::string &subtitle = "");
 	virtual void sendTip(const std::string &message);
+	virtual void sendPacket(const SerializedPacket &packet);
 
 	virtual bool isLocalPlayer() const;
 
@@ -2,6 +2,7 @@
 #include "../../ServerManager.h"
 #include "../../event/player/PlayerPickupItemEvent.h"
 #include "../../plugin/PluginManager.h"
+#include "../../event/HandlerList.h"
 #include "minecraftpe/entity/Arrow.h"
 #include "minecraftpe/entity/player/Inventory.h"
 #include "minecraftpe/level/Level.h"
@@ -17,11 +18,14 @@ void CustomArrow::playerTouch(Arrow *real, Player &player)
 		if(!real->onGround || !real->fromPlayer || real->shakeTime > 0 || player.inventory->canAdd(arrowItem))
 			return;
 
-		PlayerPickupItemEvent event(ServerManager::getServer()->getPlayer(&player), &arrowItem, 0);
-		ServerManager::getPluginManager()->callEvent(event);
+		if(PlayerPickupItemEvent::getHandlerList()->hasListeners())
+		{
+			PlayerPickupItemEvent event(ServerManager::getServer()->getPlayer(&player), &arrowItem, 0);
+			ServerManager::getPluginManager()->callEvent(event);
 
-		if(event.isCancelled())
-			return;
+			if(event.isCancelled())
+				return;
+		}
 	}
 	playerTouch_real(real, player);
 }
@@ -2,6 +2,7 @@
 #include "../../ServerManager.h"
 #include "../../event/entity/CreeperPowerEvent.h"
 #include "../../plugin/PluginManager.h"
+#include "../../event/HandlerList.h"
 #include "minecraftpe/entity/Creeper.h"
 #include "minecraftpe/level/Level.h"
 #include "Substrate.h"
@@ -9,7 +10,7 @@
 void (*CustomCreeper::onLightningHit_real)(Creeper *real);
 void CustomCreeper::onLightningHit(Creeper *real)
 {
-	if(!real->level->isClientSide())
+	if(!real->level->isClientSide() && CreeperPowerEvent::getHandlerList()->hasListeners())
 	{
 		CreeperPowerEvent event((SMCreeper *)ServerManager::getEntity(real), CreeperPowerEvent::LIGHTNING);
 		ServerManager::getPluginManager()->callEvent(event);
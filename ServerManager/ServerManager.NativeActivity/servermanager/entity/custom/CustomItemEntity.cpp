@@ -2,6 +2,7 @@
 #include "../../ServerManager.h"
 #include "../../event/player/PlayerPickupItemEvent.h"
 #include "../../plugin/PluginManager.h"
+#include "../../event/HandlerList.h"
 #include "minecraftpe/entity/ItemEntity.h"
 #include "minecraftpe/entity/player/Inventory.h"
 #include "minecraftpe/level/Level.h"
@@ -18,13 +19,16 @@ void CustomItemEntity::playerTouch(ItemEntity *real, Player &player)
 		if(!player.isAlive() || real->pickupDelay > 0 || canHold <= 0 || !player.inventory->canAdd(real->item))
 			return;
 
-		real->item.count = canHold;
-		PlayerPickupItemEvent event(ServerManager::getServer()->getPlayer(&player), &real->item, remaining);
-		ServerManager::getPluginManager()->callEvent(event);
-		real->item.count = canHold + remaining;
+		if(PlayerPickupItemEvent::getHandlerList()->hasListeners())
+		{
+			real->item.count = canHold;
+			PlayerPickupItemEvent event(ServerManager::getServer()->getPlayer(&player), &real->item, remaining);
+			ServerManager::getPluginManager()->callEvent(event);
+			real->item.count = canHold + remaining;
 
-		if(event.isCancelled())
-			return;
+			if(event.isCancelled())
+				return;
+		}
 	}
 	playerTouch_real(real, player);
 }
@@ -5,6 +5,7 @@
 #include "../../event/player/PlayerBedEnterEvent.h"
 #include "../../event/player/PlayerBedLeaveEvent.h"
 #include "../../plugin/PluginManager.h"
+#include "../../event/HandlerList.h"
 #include "minecraftpe/entity/player/Player.h"
 #include "minecraftpe/entity/player/Inventory.h"
 #include "minecraftpe/level/Level.h"
@@ -16,7 +17,7 @@
 void(*CustomPlayer::drop_real)(Player *real, ItemInstance *item, bool b);
 void CustomPlayer::drop(Player *real, ItemInstance *item, bool b)
 {
-	if(!real->level->isClientSide())
+	if(!real->level->isClientSide() && PlayerDropItemEvent::getHandlerList()->hasListeners())
 	{
 		SMPlayer *smPlayer = ServerManager::getServer()->getPlayer(real);
 
@@ -58,12 +59,15 @@ int CustomPlayer::startSleepInBed(Player *real, const BlockPos &pos)
 		if(!list.empty())
 			return 5; // not safe
 
-		FullBlock block = real->region->getBlockAndData(pos);
-		PlayerBedEnterEvent event(ServerManager::getServer()->getPlayer(real), block);
-		ServerManager::getPluginManager()->callEvent(event);
+		if(PlayerBedEnterEvent::getHandlerList()->hasListeners())
+		{
+			FullBlock block = real->region->getBlockAndData(pos);
+			PlayerBedEnterEvent event(ServerManager::getServer()->getPlayer(real), block);
+			ServerManager::getPluginManager()->callEvent(event);
 
-		if(event.isCancelled())
-			return 4; // other problem
+			if(event.isCancelled())
+				return 4; // other problem
+		}
 	}
 	return startSleepInBed_real(real, pos);
 }
@@ -79,10 +83,13 @@ void CustomPlayer::stopSleepInBed(Player *real, bool b1, bool b2)
 		if(real->region->getBlockID(real->bedPos).id != Block::mBed->id)
 			return;
 
-		FullBlock bed = real->getRegion()->getBlockAndData(real->bedPos);
+		if(PlayerBedLeaveEvent::getHandlerList()->hasListeners())
+		{
+			FullBlock bed = real->getRegion()->getBlockAndData(real->bedPos);
 
-		PlayerBedLeaveEvent event(ServerManager::getServer()->getPlayer(real), bed);
-		ServerManager::getPluginManager()->callEvent(event);
+			PlayerBedLeaveEvent event(ServerManager::getServer()->getPlayer(real), bed);
+			ServerManager::getPluginManager()->callEvent(event);
+		}
 	}
 	stopSleepInBed_real(real, b1, b2);
 }
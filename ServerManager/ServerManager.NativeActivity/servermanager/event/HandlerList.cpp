@@ -1,9 +1,14 @@
 #include <algorithm>
 
 #include "HandlerList.h"
+#include "Event.h"
+#include "Cancellable.h"
+#include "../plugin/Plugin.h"
 #include "../plugin/RegisteredListener.h"
 
 std::vector<HandlerList *> HandlerList::allLists;
+int HandlerList::activeDispatches = 0;
+std::vector<RegisteredListener *> HandlerList::removedListeners;
 
 HandlerList::HandlerList()
 {
@@ -14,6 +19,8 @@ HandlerList::HandlerList()
 	handlerslots[EventPriority::HIGHEST] = {};
 	handlerslots[EventPriority::MONITOR] = {};
 	needBake = true;
+	dispatchDepth = 0;
+	skippedCount = 0;
 
 	allLists.push_back(this);
 }
@@ -31,7 +38,7 @@ void HandlerList::unregisterAll()
 		for(auto &it : h->handlerslots)
 		{
 			for(RegisteredListener *listener : it.second)
-				delete listener;
+				release(listener);
 
 			it.second.clear();
 		}
@@ -69,12 +76,12 @@ void HandlerList::registerAll(std::vector<RegisteredListener *> listeners)
 
 void HandlerList::unregister(RegisteredListener *listener)
 {
-	std::vector<RegisteredListener *> list = handlerslots[listener->getPriority()];
+	std::vector<RegisteredListener *> &list = handlerslots[listener->getPriority()];
 	auto it = std::find(list.begin(), list.end(), listener);
 	if(it != list.end())
 	{
-		delete listener;
 		list.erase(it);
+		release(listener);
 		needBake = true;
 	}
 }
@@ -88,7 +95,7 @@ void HandlerList::unregister(Plugin *plugin)
 			RegisteredListener *listener = *it;
 			if(listener->getPlugin() == plugin)
 			{
-				delete listener;
+				release(listener);
 				it = listIter.second.erase(it);
 				needBake = true;
 			}
@@ -108,7 +115,7 @@ void HandlerList::unregister(Listener *listener)
 			RegisteredListener *registeredListener = *it;
 			if(registeredListener->getListener() == listener)
 			{
-				delete registeredListener;
+				release(registeredListener);
 				it = listIter.second.erase(it);
 				needBake = true;
 			}
@@ -120,25 +127,101 @@ void HandlerList::unregister(Listener *listener)
 
 void HandlerList::bake()
 {
-	if(!needBake)
+	// the baked array is iterated by reference, so keep it immutable while an event is being dispatched
+	if(!needBake || dispatchDepth > 0)
 		return;
 
 	handlers.clear();
+	bakedHandlers.clear();
 	needBake = false;
 
 	for(auto &it : handlerslots)
+	{
 		for(RegisteredListener *listener : it.second)
+		{
 			handlers.push_back(listener);
+
+			BakedListener baked;
+			baked.executor = &listener->getExecutor();
+			baked.listener = listener->getListener();
+			baked.registration = listener;
+			baked.ignoreCancelled = listener->isIgnoringCancelled();
+			bakedHandlers.push_back(baked);
+		}
+	}
 }
 
-const std::vector<RegisteredListener *> &HandlerList::getRegisteredListeners()
+void HandlerList::callEvent(Event &event)
+{
+	const std::vector<BakedListener> &listeners = getBakedListeners();
+	if(listeners.empty())
+		return;
+
+	bool timed = ListenerTimings::isEnabled();
+
+	++dispatchDepth;
+	++activeDispatches;
+	for(const BakedListener &baked : listeners)
+	{
+		// checked live, an earlier listener may have disabled a plugin or unregistered this one
+		if(baked.registration->isUnregistered() || !baked.registration->getPlugin()->isEnabled())
+			continue;
+
+		if(timed)
+		{
+			baked.registration->callEvent(event);
+			continue;
+		}
+
+		if(baked.ignoreCancelled && event.isCancellable() && ((Cancellable &)event).isCancelled())
+			continue;
+
+		(*baked.executor)(baked.listener, event);
+	}
+	--dispatchDepth;
+
+	if(--activeDispatches == 0 && !removedListeners.empty())
+	{
+		std::vector<RegisteredListener *> removed;
+		removed.swap(removedListeners);
+		for(RegisteredListener *listener : removed)
+			delete listener;
+	}
+}
+
+// Callers use this to avoid constructing events nobody listens to,
+// so every negative answer is counted as a skipped construction.
+bool HandlerList::hasListeners()
 {
-	while(needBake)
+	if(needBake)
 		bake();
 
+	if(!bakedHandlers.empty())
+		return true;
+
+	++skippedCount;
+	return false;
+}
+
+unsigned int HandlerList::getSkippedCount() const
+{
+	return skippedCount;
+}
+
+const std::vector<RegisteredListener *> &HandlerList::getRegisteredListeners()
+{
+	bake();
+
 	return handlers;
 }
 
+const std::vector<HandlerList::BakedListener> &HandlerList::getBakedListeners()
+{
+	bake();
+
+	return bakedHandlers;
+}
+
 std::vector<RegisteredListener *> HandlerList::getRegisteredListeners(Plugin *plugin)
 {
 	std::vector<RegisteredListener *> listeners;
@@ -148,9 +231,20 @@ std::vector<RegisteredListener *> HandlerList::getRegisteredListeners(Plugin *pl
 			for(RegisteredListener *listener : it.second)
 				if(listener->getPlugin() == plugin)
 					listeners.push_back(listener);
+
+	return listeners;
 }
 
 const std::vector<HandlerList *> &HandlerList::getHandlerLists()
 {
 	return allLists;
 }
+
+void HandlerList::release(RegisteredListener *listener)
+{
+	listener->setUnregistered();
+	if(activeDispatches > 0)
+		removedListeners.push_back(listener);
+	else
+		delete listener;
+}
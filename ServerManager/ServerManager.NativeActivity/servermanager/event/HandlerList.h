@@ -4,20 +4,38 @@
 #include <map>
 
 #include "EventPriority.h"
+#include "EventExecutor.h"
 
 class Plugin;
 class Listener;
 class RegisteredListener;
+class Event;
 
 class HandlerList
 {
+public:
+	struct BakedListener
+	{
+		const EventExecutor *executor;
+		Listener *listener;
+		RegisteredListener *registration;
+		bool ignoreCancelled;
+	};
+
 private:
 	std::vector<RegisteredListener *> handlers;
+	std::vector<BakedListener> bakedHandlers;
 	std::map<EventPriority, std::vector<RegisteredListener *>> handlerslots;
 	bool needBake;
+	int dispatchDepth;
+	unsigned int skippedCount;
 
 	static std::vector<HandlerList *> allLists;
 
+	// listeners removed while any list is dispatching are freed once the outermost dispatch returns
+	static int activeDispatches;
+	static std::vector<RegisteredListener *> removedListeners;
+
 public:
 	HandlerList();
 
@@ -36,8 +54,17 @@ public:
 
 	void bake();
 
+	void callEvent(Event &event);
+
+	bool hasListeners();
+	unsigned int getSkippedCount() const;
+
 	const std::vector<RegisteredListener *> &getRegisteredListeners();
+	const std::vector<BakedListener> &getBakedListeners();
 	std::vector<RegisteredListener *> getRegisteredListeners(Plugin *plugin);
 
 	static const std::vector<HandlerList *> &getHandlerLists();
+
+private:
+	static void release(RegisteredListener *listener);
 };
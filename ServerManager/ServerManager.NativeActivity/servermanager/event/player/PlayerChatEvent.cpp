@@ -5,11 +5,13 @@
 
 HandlerList *PlayerChatEvent::handlers = new HandlerList;
 
+const char *PlayerChatEvent::DEFAULT_FORMAT = "<%s> %s";
+
 PlayerChatEvent::PlayerChatEvent(SMPlayer *who, const std::string &message)
 	: PlayerEvent(who)
 {
 	this->message = message;
-	format = "<%s> %s";
+	format = DEFAULT_FORMAT;
 	cancel = false;
 }
 
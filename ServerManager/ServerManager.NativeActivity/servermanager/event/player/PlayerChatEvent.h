@@ -11,6 +11,9 @@ private:
 	std::string format;
 	bool cancel;
 
+public:
+	static const char *DEFAULT_FORMAT;
+
 public:
 	PlayerChatEvent(SMPlayer *who, const std::string &message);
 
@@ -0,0 +1,136 @@
+#include "PlayerSaveQueue.h"
+#include "custom/CustomLevelStorage.h"
+#include "minecraftpe/level/LevelStorage.h"
+
+const int PlayerSaveQueue::MAX_BATCH;
+
+PlayerSaveQueue::PlayerSaveQueue()
+{
+	capturing = false;
+
+	queuedSaves = 0;
+	mergedSaves = 0;
+	writtenSaves = 0;
+	batches = 0;
+}
+
+// Server::stop flushes while the level is still there, by now the storage may be gone and nothing is written
+PlayerSaveQueue::~PlayerSaveQueue()
+{
+	pending.clear();
+}
+
+void PlayerSaveQueue::snapshot(LevelStorage *storage, Player &player, const std::string &owner)
+{
+	capturingOwner = owner;
+	capturing = true;
+	storage->save(player);
+	capturing = false;
+	capturingOwner.clear();
+}
+
+bool PlayerSaveQueue::isCapturing() const
+{
+	return capturing;
+}
+
+void PlayerSaveQueue::enqueue(LevelStorage *storage, const std::string &key, std::string &&data)
+{
+	++queuedSaves;
+
+	// a newer save of the same player replaces the one still waiting
+	for(Entry &entry : pending)
+	{
+		if(entry.storage == storage && entry.key == key)
+		{
+			entry.data = std::move(data);
+			entry.owner = capturingOwner;
+			++mergedSaves;
+			return;
+		}
+	}
+
+	Entry entry;
+	entry.storage = storage;
+	entry.key = key;
+	entry.data = std::move(data);
+	entry.owner = capturingOwner;
+	pending.push_back(std::move(entry));
+}
+
+void PlayerSaveQueue::tick()
+{
+	write(MAX_BATCH);
+}
+
+void PlayerSaveQueue::flush(LevelStorage *storage, const std::string &owner)
+{
+	size_t written = 0;
+	for(auto it = pending.begin(); it != pending.end();)
+	{
+		if(it->storage == storage && it->owner == owner)
+		{
+			write(*it);
+			it = pending.erase(it);
+			++written;
+		}
+		else
+			++it;
+	}
+
+	if(written > 0)
+	{
+		writtenSaves += written;
+		++batches;
+	}
+}
+
+void PlayerSaveQueue::flush()
+{
+	write(pending.size());
+}
+
+size_t PlayerSaveQueue::size() const
+{
+	return pending.size();
+}
+
+unsigned long long PlayerSaveQueue::getQueuedSaves() const
+{
+	return queuedSaves;
+}
+
+unsigned long long PlayerSaveQueue::getMergedSaves() const
+{
+	return mergedSaves;
+}
+
+unsigned long long PlayerSaveQueue::getWrittenSaves() const
+{
+	return writtenSaves;
+}
+
+unsigned long long PlayerSaveQueue::getBatches() const
+{
+	return batches;
+}
+
+void PlayerSaveQueue::write(size_t count)
+{
+	if(count > pending.size())
+		count = pending.size();
+	if(count == 0)
+		return;
+
+	for(size_t i = 0; i < count; ++i)
+		write(pending[i]);
+
+	pending.erase(pending.begin(), pending.begin() + count);
+	writtenSaves += count;
+	++batches;
+}
+
+void PlayerSaveQueue::write(Entry &entry)
+{
+	CustomLevelStorage::saveData_real(entry.storage, entry.key, std::move(entry.data));
+}
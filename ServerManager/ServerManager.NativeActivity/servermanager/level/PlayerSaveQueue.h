@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <atomic>
+
+class LevelStorage;
+class Player;
+
+// takes the encoded player data at disconnect and writes it to the level database a few players per tick
+// DBStorage is not safe to use from another thread, so the writes stay on the game thread
+class PlayerSaveQueue
+{
+public:
+	static const int MAX_BATCH = 4;
+
+private:
+	struct Entry
+	{
+		LevelStorage *storage;
+		std::string key;
+		std::string data;
+		// lowercase name of the player the save was taken from
+		std::string owner;
+	};
+
+	std::vector<Entry> pending;
+	std::atomic<bool> capturing;
+	std::string capturingOwner;
+
+	unsigned long long queuedSaves;
+	unsigned long long mergedSaves;
+	unsigned long long writtenSaves;
+	unsigned long long batches;
+
+public:
+	PlayerSaveQueue();
+	~PlayerSaveQueue();
+
+	// runs the game's own save for the player, the database write it ends in is queued instead
+	void snapshot(LevelStorage *storage, Player &player, const std::string &owner);
+	bool isCapturing() const;
+	void enqueue(LevelStorage *storage, const std::string &key, std::string &&data);
+
+	// writes the next batch, called from Server::tick
+	void tick();
+	// writes what is queued for one player, so a reconnect reads back the data it left with
+	void flush(LevelStorage *storage, const std::string &owner);
+	// writes every queued save, when the server stops
+	void flush();
+
+	size_t size() const;
+	unsigned long long getQueuedSaves() const;
+	unsigned long long getMergedSaves() const;
+	unsigned long long getWrittenSaves() const;
+	unsigned long long getBatches() const;
+
+private:
+	void write(size_t count);
+	void write(Entry &entry);
+};
@@ -12,7 +12,17 @@ void CustomLevel::removeEntity(Level *real, Entity *entity, bool b)
 	removeEntity_real(real, entity, b);
 }
 
+void(*CustomLevel::tick_real)(Level *real);
+void CustomLevel::tick(Level *real)
+{
+	tick_real(real);
+
+	if(!real->isClientSide())
+		ServerManager::getServer()->tick();
+}
+
 void CustomLevel::setupHooks()
 {
 	MSHookFunction(dlsym(RTLD_DEFAULT, "_ZN5Level12removeEntityER6Entityb"), (void *)&removeEntity, (void **)&removeEntity_real);
+	MSHookFunction(dlsym(RTLD_DEFAULT, "_ZN5Level4tickEv"), (void *)&tick, (void **)&tick_real);
 }
@@ -13,5 +13,8 @@ public:
 	static void (*removeEntity_real)(Level *, Entity *, bool);
 	static void removeEntity(Level *, Entity *, bool);
 
+	static void (*tick_real)(Level *);
+	static void tick(Level *);
+
 	static void setupHooks();
 };
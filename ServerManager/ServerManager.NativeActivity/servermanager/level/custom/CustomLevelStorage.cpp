@@ -0,0 +1,23 @@
+#include <dlfcn.h>
+
+#include "CustomLevelStorage.h"
+#include "../PlayerSaveQueue.h"
+#include "../../ServerManager.h"
+#include "Substrate.h"
+
+void(*CustomLevelStorage::saveData_real)(LevelStorage *real, const std::string &key, std::string &&data);
+void CustomLevelStorage::saveData(LevelStorage *real, const std::string &key, std::string &&data)
+{
+	PlayerSaveQueue *playerSaves = ServerManager::getServer()->getPlayerSaveQueue();
+	if(playerSaves->isCapturing())
+	{
+		playerSaves->enqueue(real, key, std::move(data));
+		return;
+	}
+	saveData_real(real, key, std::move(data));
+}
+
+void CustomLevelStorage::setupHooks()
+{
+	MSHookFunction(dlsym(RTLD_DEFAULT, "_ZN9DBStorage8saveDataERKSsOSs"), (void *)&saveData, (void **)&saveData_real);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+
+class LevelStorage;
+
+class CustomLevelStorage
+{
+public:
+	static void (*saveData_real)(LevelStorage *, const std::string &, std::string &&);
+	static void saveData(LevelStorage *, const std::string &, std::string &&);
+
+	static void setupHooks();
+};
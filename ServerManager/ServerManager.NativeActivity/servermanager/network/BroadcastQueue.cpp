@@ -0,0 +1,216 @@
+#include <memory>
+#include <functional>
+
+#include "BroadcastQueue.h"
+#include "SerializedPacket.h"
+#include "../util/SMUtil.h"
+#include "minecraftpe/network/PacketSender.h"
+
+BroadcastQueue::Slots::Slots()
+{
+	tip = -1;
+	popup = -1;
+}
+
+BroadcastQueue::BroadcastQueue()
+{
+	sentPackets = 0;
+	savedPackets = 0;
+	sharedEncodes = 0;
+}
+
+// each line gets its own packet, the client draws one chat entry per packet and does not break lines itself
+void BroadcastQueue::queueMessage(const RakNet::RakNetGUID *target, const std::string &message)
+{
+	for(std::string m : SMUtil::split(message, '\n'))
+	{
+		if(m.empty())
+			continue;
+
+		TextPacket pk;
+		pk.type = TextPacket::TYPE_RAW;
+		pk.message = m;
+		push(target, pk);
+	}
+}
+
+void BroadcastQueue::queueTranslation(const RakNet::RakNetGUID *target, const std::string &message, const std::vector<std::string> &params)
+{
+	TextPacket pk;
+	pk.type = TextPacket::TYPE_TRANSLATION;
+	pk.message = message;
+	pk.params = params;
+	push(target, pk);
+}
+
+void BroadcastQueue::queueTip(const RakNet::RakNetGUID *target, const std::string &message)
+{
+	Slots &slots = getSlots(target);
+
+	// a later tip replaces the earlier one on screen, so only the last of the tick is sent
+	if(slots.tip >= 0)
+	{
+		entries[slots.tip].packet.message = message;
+		++savedPackets;
+		return;
+	}
+
+	TextPacket pk;
+	pk.type = TextPacket::TYPE_TIP;
+	pk.message = message;
+	slots.tip = entries.size();
+	push(target, pk);
+}
+
+void BroadcastQueue::queuePopup(const RakNet::RakNetGUID *target, const std::string &message, const std::string &subtitle)
+{
+	Slots &slots = getSlots(target);
+
+	if(slots.popup >= 0)
+	{
+		entries[slots.popup].packet.source = message;
+		entries[slots.popup].packet.message = subtitle;
+		++savedPackets;
+		return;
+	}
+
+	TextPacket pk;
+	pk.type = TextPacket::TYPE_POPUP;
+	pk.source = message;
+	pk.message = subtitle;
+	slots.popup = entries.size();
+	push(target, pk);
+}
+
+void BroadcastQueue::remove(const RakNet::RakNetGUID &target)
+{
+	if(!recipients.erase(target.g))
+		return;
+
+	std::vector<Entry> kept;
+	kept.reserve(entries.size());
+	for(Entry &entry : entries)
+	{
+		if(!entry.targeted || entry.guid.g != target.g)
+			kept.push_back(entry);
+	}
+	entries.swap(kept);
+
+	// dropping the player's packets moved everything behind them
+	everyone = Slots();
+	for(auto &it : recipients)
+		it.second = Slots();
+
+	for(int i = 0; i < (int)entries.size(); ++i)
+	{
+		Slots &slots = getSlots(entries[i].targeted ? &entries[i].guid : NULL);
+		if(entries[i].packet.type == TextPacket::TYPE_TIP)
+			slots.tip = i;
+		else if(entries[i].packet.type == TextPacket::TYPE_POPUP)
+			slots.popup = i;
+	}
+}
+
+void BroadcastQueue::flush(PacketSender *sender, RakNetInstance *raknet)
+{
+	// plugins often send the same line to each player in turn, so every distinct packet is encoded once
+	std::unordered_multimap<size_t, std::pair<const TextPacket *, std::unique_ptr<SerializedPacket>>> encoded;
+
+	for(Entry &entry : entries)
+	{
+		TextPacket &pk = entry.packet;
+		if(!entry.targeted)
+		{
+			sender->send(pk);
+			continue;
+		}
+
+		if(!raknet)
+		{
+			sender->send(entry.guid, pk);
+			continue;
+		}
+
+		size_t key = hash(pk);
+		SerializedPacket *serialized = NULL;
+
+		auto range = encoded.equal_range(key);
+		for(auto it = range.first; it != range.second; ++it)
+		{
+			if(equals(*it->second.first, pk))
+			{
+				serialized = it->second.second.get();
+				++sharedEncodes;
+				break;
+			}
+		}
+
+		if(!serialized)
+		{
+			serialized = new SerializedPacket(pk);
+			encoded.insert(std::make_pair(key, std::make_pair(&pk, std::unique_ptr<SerializedPacket>(serialized))));
+		}
+		serialized->send(raknet, entry.guid);
+	}
+	sentPackets += entries.size();
+
+	clear();
+}
+
+void BroadcastQueue::clear()
+{
+	entries.clear();
+	everyone = Slots();
+	recipients.clear();
+}
+
+unsigned long long BroadcastQueue::getSentPackets() const
+{
+	return sentPackets;
+}
+
+unsigned long long BroadcastQueue::getSavedPackets() const
+{
+	return savedPackets;
+}
+
+unsigned long long BroadcastQueue::getSharedEncodes() const
+{
+	return sharedEncodes;
+}
+
+void BroadcastQueue::push(const RakNet::RakNetGUID *target, const TextPacket &pk)
+{
+	getSlots(target);
+
+	Entry entry;
+	entry.targeted = target != NULL;
+	if(target)
+		entry.guid = *target;
+	entry.packet = pk;
+	entries.push_back(entry);
+}
+
+BroadcastQueue::Slots &BroadcastQueue::getSlots(const RakNet::RakNetGUID *target)
+{
+	if(!target)
+		return everyone;
+
+	return recipients[target->g];
+}
+
+size_t BroadcastQueue::hash(const TextPacket &pk)
+{
+	std::hash<std::string> hasher;
+
+	size_t key = hasher(pk.message) * 31 + pk.type;
+	key = key * 31 + hasher(pk.source);
+	for(const std::string &param : pk.params)
+		key = key * 31 + hasher(param);
+	return key;
+}
+
+bool BroadcastQueue::equals(const TextPacket &a, const TextPacket &b)
+{
+	return a.type == b.type && a.message == b.message && a.source == b.source && a.params == b.params;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "minecraftpe/network/protocol/TextPacket.h"
+#include "raknet/RakNetTypes.h"
+
+class PacketSender;
+class RakNetInstance;
+
+// collects the text output of one tick and sends it in the order it was queued
+class BroadcastQueue
+{
+private:
+	struct Entry
+	{
+		// false for packets that go to every player
+		bool targeted;
+		RakNet::RakNetGUID guid;
+		TextPacket packet;
+	};
+
+	// where the tip and popup of a recipient sit in the queue, -1 while it has none
+	struct Slots
+	{
+		int tip;
+		int popup;
+
+		Slots();
+	};
+
+	std::vector<Entry> entries;
+	Slots everyone;
+	std::unordered_map<unsigned long long, Slots> recipients;
+
+	unsigned long long sentPackets;
+	unsigned long long savedPackets;
+	unsigned long long sharedEncodes;
+
+public:
+	BroadcastQueue();
+
+	// a NULL target queues for every player
+	void queueMessage(const RakNet::RakNetGUID *target, const std::string &message);
+	void queueTranslation(const RakNet::RakNetGUID *target, const std::string &message, const std::vector<std::string> &params);
+	void queueTip(const RakNet::RakNetGUID *target, const std::string &message);
+	void queuePopup(const RakNet::RakNetGUID *target, const std::string &message, const std::string &subtitle);
+
+	void remove(const RakNet::RakNetGUID &target);
+	void flush(PacketSender *sender, RakNetInstance *raknet);
+	void clear();
+
+	unsigned long long getSentPackets() const;
+	unsigned long long getSavedPackets() const;
+	unsigned long long getSharedEncodes() const;
+
+private:
+	void push(const RakNet::RakNetGUID *target, const TextPacket &pk);
+	Slots &getSlots(const RakNet::RakNetGUID *target);
+
+	static size_t hash(const TextPacket &pk);
+	static bool equals(const TextPacket &a, const TextPacket &b);
+};
@@ -0,0 +1,115 @@
+#include "LoginQueue.h"
+#include "minecraftpe/network/protocol/LoginPacket.h"
+
+LoginQueue::LoginQueue()
+{
+	configure(2, 5);
+}
+
+void LoginQueue::configure(int maxPerTick, int maxPerAddress)
+{
+	this->maxPerTick = maxPerTick;
+	this->maxPerAddress = maxPerAddress;
+}
+
+bool LoginQueue::allowAddress(const std::string &address, unsigned long long nowMillis)
+{
+	if(maxPerAddress <= 0)
+		return true;
+
+	// forget addresses that have been quiet for a whole window
+	if(attempts.size() > 1024)
+	{
+		for(auto it = attempts.begin(); it != attempts.end();)
+		{
+			if(it->second.empty() || nowMillis - it->second.back() > ADDRESS_WINDOW)
+				it = attempts.erase(it);
+			else
+				++it;
+		}
+	}
+
+	std::deque<unsigned long long> &times = attempts[address];
+	while(!times.empty() && nowMillis - times.front() > ADDRESS_WINDOW)
+		times.pop_front();
+
+	if((int)times.size() >= maxPerAddress)
+		return false;
+
+	times.push_back(nowMillis);
+	return true;
+}
+
+bool LoginQueue::enqueue(ServerNetworkHandler *handler, Processor processor, const RakNet::RakNetGUID &guid, LoginPacket &packet, SkinValidator *skinValidator)
+{
+	if(isPending(guid))
+		return false;
+
+	Pending entry;
+	entry.handler = handler;
+	entry.processor = processor;
+	entry.guid = guid;
+	// the game drops its packet once the handler returns, so the skin is taken from it rather than copied
+	entry.skin = skinValidator->submit(std::move(packet.skin));
+	entry.packet.reset(new LoginPacket(packet));
+	pending.push_back(std::move(entry));
+	return true;
+}
+
+bool LoginQueue::isPending(const RakNet::RakNetGUID &guid) const
+{
+	for(const Pending &entry : pending)
+	{
+		if(entry.guid.g == guid.g)
+			return true;
+	}
+	return false;
+}
+
+void LoginQueue::remove(const RakNet::RakNetGUID &guid)
+{
+	for(auto it = pending.begin(); it != pending.end(); ++it)
+	{
+		if(it->guid.g == guid.g)
+		{
+			pending.erase(it);
+			return;
+		}
+	}
+}
+
+void LoginQueue::clear()
+{
+	pending.clear();
+	attempts.clear();
+}
+
+int LoginQueue::process()
+{
+	int processed = 0;
+	while(maxPerTick <= 0 || processed < maxPerTick)
+	{
+		// logins whose skin is still being checked let the ones behind them go first
+		auto it = pending.begin();
+		while(it != pending.end() && !it->skin->isDone())
+			++it;
+
+		if(it == pending.end())
+			break;
+
+		// the entry leaves the queue first, a failed login disconnects and would remove it again
+		Pending entry = std::move(*it);
+		pending.erase(it);
+
+		entry.packet->skin = std::move(entry.skin->getData());
+
+		entry.processor(entry.handler, entry.guid, entry.packet.get(), entry.skin->isValid());
+		++processed;
+	}
+	return processed;
+}
+
+size_t LoginQueue::size() const
+{
+	return pending.size();
+}
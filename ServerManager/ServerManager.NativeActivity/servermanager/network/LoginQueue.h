@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+#include "../util/SkinValidator.h"
+#include "raknet/RakNetTypes.h"
+
+class ServerNetworkHandler;
+class LoginPacket;
+
+// holds accepted LoginPackets until the tick has room to run the expensive part of the join
+class LoginQueue
+{
+public:
+	typedef void (*Processor)(ServerNetworkHandler *, const RakNet::RakNetGUID &, LoginPacket *, bool validSkin);
+
+	static const unsigned long long ADDRESS_WINDOW = 10000;
+
+private:
+	struct Pending
+	{
+		ServerNetworkHandler *handler;
+		Processor processor;
+		RakNet::RakNetGUID guid;
+		std::unique_ptr<LoginPacket> packet;
+		std::shared_ptr<SkinValidator::Request> skin;
+	};
+
+	std::deque<Pending> pending;
+	std::unordered_map<std::string, std::deque<unsigned long long>> attempts;
+
+	int maxPerTick;
+	int maxPerAddress;
+
+public:
+	LoginQueue();
+
+	void configure(int maxPerTick, int maxPerAddress);
+
+	// counts an attempt from the address and tells whether it is still within its budget
+	bool allowAddress(const std::string &address, unsigned long long nowMillis);
+
+	// the skin is moved to the validator, the entry waits until it has been checked
+	bool enqueue(ServerNetworkHandler *handler, Processor processor, const RakNet::RakNetGUID &guid, LoginPacket &packet, SkinValidator *skinValidator);
+	bool isPending(const RakNet::RakNetGUID &guid) const;
+	void remove(const RakNet::RakNetGUID &guid);
+	void clear();
+
+	int process();
+	size_t size() const;
+};
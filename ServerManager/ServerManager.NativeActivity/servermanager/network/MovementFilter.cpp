@@ -0,0 +1,95 @@
+#include <cmath>
+
+#include "MovementFilter.h"
+
+MovementFilter::State::State()
+{
+	x = y = z = 0.0f;
+	pitch = yaw = headYaw = 0.0f;
+
+	tick = 0;
+	moves = 0;
+	valid = false;
+}
+
+MovementFilter::MovementFilter()
+{
+	configure(0.0625f, 1.0f, 2);
+
+	currentTick = 0;
+	resetCounters();
+}
+
+void MovementFilter::configure(float minDistance, float minRotation, int maxMovesPerTick)
+{
+	this->minDistanceSq = minDistance * minDistance;
+	this->minRotation = minRotation;
+	this->maxMovesPerTick = maxMovesPerTick;
+}
+
+void MovementFilter::tick()
+{
+	++currentTick;
+}
+
+bool MovementFilter::accept(State &state, float x, float y, float z, float pitch, float yaw, float headYaw, bool force)
+{
+	if(state.tick != currentTick)
+	{
+		state.tick = currentTick;
+		state.moves = 0;
+	}
+
+	if(!force && state.valid)
+	{
+		if(maxMovesPerTick > 0 && state.moves >= maxMovesPerTick)
+		{
+			++droppedRateMoves;
+			return false;
+		}
+
+		float dx = x - state.x;
+		float dy = y - state.y;
+		float dz = z - state.z;
+		if(dx * dx + dy * dy + dz * dz < minDistanceSq && fabs(pitch - state.pitch) < minRotation
+			&& fabs(yaw - state.yaw) < minRotation && fabs(headYaw - state.headYaw) < minRotation)
+		{
+			++droppedSmallMoves;
+			return false;
+		}
+	}
+
+	state.x = x;
+	state.y = y;
+	state.z = z;
+	state.pitch = pitch;
+	state.yaw = yaw;
+	state.headYaw = headYaw;
+	state.moves++;
+	state.valid = true;
+
+	++processedMoves;
+	return true;
+}
+
+unsigned long long MovementFilter::getProcessedMoves() const
+{
+	return processedMoves;
+}
+
+unsigned long long MovementFilter::getDroppedSmallMoves() const
+{
+	return droppedSmallMoves;
+}
+
+unsigned long long MovementFilter::getDroppedRateMoves() const
+{
+	return droppedRateMoves;
+}
+
+void MovementFilter::resetCounters()
+{
+	processedMoves = 0;
+	droppedSmallMoves = 0;
+	droppedRateMoves = 0;
+}
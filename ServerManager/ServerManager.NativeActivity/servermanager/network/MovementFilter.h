@@ -0,0 +1,47 @@
+#pragma once
+
+// drops movement packets that change too little, and caps how many one player may have processed per tick
+class MovementFilter
+{
+public:
+	struct State
+	{
+		float x;
+		float y;
+		float z;
+		float pitch;
+		float yaw;
+		float headYaw;
+
+		unsigned int tick;
+		int moves;
+		bool valid;
+
+		State();
+	};
+
+private:
+	float minDistanceSq;
+	float minRotation;
+	int maxMovesPerTick;
+
+	unsigned int currentTick;
+
+	unsigned long long processedMoves;
+	unsigned long long droppedSmallMoves;
+	unsigned long long droppedRateMoves;
+
+public:
+	MovementFilter();
+
+	void configure(float minDistance, float minRotation, int maxMovesPerTick);
+	void tick();
+
+	// moves dropped here are absolute positions, so the next accepted move carries the player the whole way
+	bool accept(State &state, float x, float y, float z, float pitch, float yaw, float headYaw, bool force);
+
+	unsigned long long getProcessedMoves() const;
+	unsigned long long getDroppedSmallMoves() const;
+	unsigned long long getDroppedRateMoves() const;
+	void resetCounters();
+};
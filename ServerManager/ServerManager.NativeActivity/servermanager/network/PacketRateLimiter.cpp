@@ -0,0 +1,143 @@
+#include <ctime>
+
+#include "PacketRateLimiter.h"
+#include "PacketID.h"
+
+PacketRateLimiter::Connection::Connection()
+{
+	violations = 0.0f;
+	lastViolation = 0;
+}
+
+PacketRateLimiter::PacketRateLimiter()
+{
+	setDefaultBudget(100.0f, 200.0f);
+
+	// packets that run plugin events or world changes on the main thread get tighter budgets
+	setBudget(PACKET_TEXT, 4.0f, 10.0f);
+	setBudget(PACKET_USE_ITEM, 20.0f, 40.0f);
+	setBudget(PACKET_ANIMATE, 20.0f, 40.0f);
+
+	kickThreshold = 100.0f;
+	violationDecay = 10.0f;
+
+	resetCounters();
+}
+
+void PacketRateLimiter::setDefaultBudget(float rate, float burst)
+{
+	defaultBudget.rate = rate;
+	defaultBudget.burst = burst;
+}
+
+void PacketRateLimiter::setBudget(int packetId, float rate, float burst)
+{
+	Budget &budget = budgets[packetId];
+	budget.rate = rate;
+	budget.burst = burst;
+}
+
+void PacketRateLimiter::setKickThreshold(float violations)
+{
+	kickThreshold = violations;
+}
+
+PacketRateLimiter::Verdict PacketRateLimiter::check(unsigned long long guid, int packetId, unsigned long long nowMillis)
+{
+	const Budget &budget = getBudget(packetId);
+	if(budget.rate <= 0.0f)
+	{
+		++counters.allowed;
+		return ALLOW;
+	}
+
+	Connection &connection = connections[guid];
+
+	auto it = connection.buckets.find(packetId);
+	if(it == connection.buckets.end())
+	{
+		Bucket bucket = {budget.burst, nowMillis};
+		it = connection.buckets.insert(std::make_pair(packetId, bucket)).first;
+	}
+
+	Bucket &bucket = it->second;
+	if(nowMillis > bucket.lastRefill)
+	{
+		bucket.tokens += (nowMillis - bucket.lastRefill) * budget.rate / 1000.0f;
+		if(bucket.tokens > budget.burst)
+			bucket.tokens = budget.burst;
+		bucket.lastRefill = nowMillis;
+	}
+
+	if(bucket.tokens >= 1.0f)
+	{
+		bucket.tokens -= 1.0f;
+		++counters.allowed;
+		return ALLOW;
+	}
+
+	// violations wear off over time, so only a sustained flood ends in a kick
+	if(connection.violations > 0.0f && nowMillis > connection.lastViolation)
+	{
+		connection.violations -= (nowMillis - connection.lastViolation) * violationDecay / 1000.0f;
+		if(connection.violations < 0.0f)
+			connection.violations = 0.0f;
+	}
+	connection.violations += 1.0f;
+	connection.lastViolation = nowMillis;
+
+	++droppedById[packetId];
+
+	if(kickThreshold > 0.0f && connection.violations >= kickThreshold)
+	{
+		++counters.kicked;
+		connections.erase(guid);
+		return KICK;
+	}
+
+	++counters.dropped;
+	return DROP;
+}
+
+void PacketRateLimiter::remove(unsigned long long guid)
+{
+	connections.erase(guid);
+}
+
+void PacketRateLimiter::clear()
+{
+	connections.clear();
+}
+
+const PacketRateLimiter::Counters &PacketRateLimiter::getCounters() const
+{
+	return counters;
+}
+
+const std::map<int, unsigned long long> &PacketRateLimiter::getDroppedById() const
+{
+	return droppedById;
+}
+
+void PacketRateLimiter::resetCounters()
+{
+	counters.allowed = 0;
+	counters.dropped = 0;
+	counters.kicked = 0;
+	droppedById.clear();
+}
+
+unsigned long long PacketRateLimiter::currentMillis()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000ULL + ts.tv_nsec / 1000000;
+}
+
+const PacketRateLimiter::Budget &PacketRateLimiter::getBudget(int packetId) const
+{
+	auto it = budgets.find(packetId);
+	if(it != budgets.end())
+		return it->second;
+	return defaultBudget;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <map>
+#include <unordered_map>
+
+// token buckets per connection and packet id; time is passed in so recorded packet streams can be replayed
+class PacketRateLimiter
+{
+public:
+	enum Verdict
+	{
+		ALLOW,
+		DROP,
+		KICK
+	};
+
+	struct Budget
+	{
+		float rate;
+		float burst;
+	};
+
+	struct Counters
+	{
+		unsigned long long allowed;
+		unsigned long long dropped;
+		unsigned long long kicked;
+	};
+
+private:
+	struct Bucket
+	{
+		float tokens;
+		unsigned long long lastRefill;
+	};
+
+	struct Connection
+	{
+		std::unordered_map<int, Bucket> buckets;
+		float violations;
+		unsigned long long lastViolation;
+
+		Connection();
+	};
+
+	Budget defaultBudget;
+	std::map<int, Budget> budgets;
+	float kickThreshold;
+	float violationDecay;
+
+	std::unordered_map<unsigned long long, Connection> connections;
+
+	Counters counters;
+	std::map<int, unsigned long long> droppedById;
+
+public:
+	PacketRateLimiter();
+
+	void setDefaultBudget(float rate, float burst);
+	void setBudget(int packetId, float rate, float burst);
+	void setKickThreshold(float violations);
+
+	Verdict check(unsigned long long guid, int packetId, unsigned long long nowMillis);
+	void remove(unsigned long long guid);
+	void clear();
+
+	const Counters &getCounters() const;
+	const std::map<int, unsigned long long> &getDroppedById() const;
+	void resetCounters();
+
+	static unsigned long long currentMillis();
+
+private:
+	const Budget &getBudget(int packetId) const;
+};
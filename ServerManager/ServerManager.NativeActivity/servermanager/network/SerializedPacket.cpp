@@ -0,0 +1,23 @@
+#include "SerializedPacket.h"
+#include "minecraftpe/network/RakNetInstance.h"
+#include "minecraftpe/network/protocol/Packet.h"
+#include "raknet/RakPeerInterface.h"
+
+SerializedPacket::SerializedPacket(const Packet &packet)
+{
+	priority = packet.priority;
+	reliability = packet.reliability;
+
+	// packets write their own id byte, exactly as RakNetInstance::send encodes them
+	packet.write(&stream);
+}
+
+void SerializedPacket::send(RakNetInstance *raknet, const RakNet::RakNetGUID &guid) const
+{
+	raknet->getPeer()->Send(&stream, priority, reliability, 0, guid, false);
+}
+
+unsigned int SerializedPacket::getSize() const
+{
+	return stream.GetNumberOfBytesUsed();
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "raknet/BitStream.h"
+#include "raknet/PacketPriority.h"
+#include "raknet/RakNetTypes.h"
+
+class Packet;
+class RakNetInstance;
+
+// a packet encoded once so the same bytes can be handed to any number of recipients
+class SerializedPacket
+{
+private:
+	RakNet::BitStream stream;
+	PacketPriority priority;
+	PacketReliability reliability;
+
+public:
+	SerializedPacket(const Packet &packet);
+
+	void send(RakNetInstance *raknet, const RakNet::RakNetGUID &guid) const;
+
+	unsigned int getSize() const;
+};
@@ -0,0 +1,64 @@
+#include "ServerAnnouncer.h"
+#include "minecraftpe/network/RakNetInstance.h"
+#include "raknet/RakPeerInterface.h"
+
+ServerAnnouncer::ServerAnnouncer()
+{
+	dirty = false;
+	interval = 0;
+	lastAnnounce = 0;
+	announceCount = 0;
+	requestCount = 0;
+}
+
+void ServerAnnouncer::setInterval(unsigned long long millis)
+{
+	interval = millis;
+}
+
+void ServerAnnouncer::markDirty()
+{
+	dirty = true;
+	++requestCount;
+}
+
+bool ServerAnnouncer::update(RakNetInstance *raknet, const std::string &name, unsigned long long nowMillis)
+{
+	if(!dirty || !raknet)
+		return false;
+
+	if(interval > 0 && announceCount > 0 && nowMillis - lastAnnounce < interval)
+		return false;
+
+	announce(raknet, name, nowMillis);
+	return true;
+}
+
+void ServerAnnouncer::announce(RakNetInstance *raknet, const std::string &name, unsigned long long nowMillis)
+{
+	raknet->announceServer(name);
+
+	char *data = NULL;
+	unsigned int length = 0;
+	raknet->getPeer()->GetOfflinePingResponse(&data, &length);
+	pingResponse.assign(data ? data : "", data ? length : 0);
+
+	dirty = false;
+	lastAnnounce = nowMillis;
+	++announceCount;
+}
+
+const std::string &ServerAnnouncer::getPingResponse() const
+{
+	return pingResponse;
+}
+
+unsigned long long ServerAnnouncer::getAnnounceCount() const
+{
+	return announceCount;
+}
+
+unsigned long long ServerAnnouncer::getRequestCount() const
+{
+	return requestCount;
+}
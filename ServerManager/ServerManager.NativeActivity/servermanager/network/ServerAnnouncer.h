@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+
+class RakNetInstance;
+
+// coalesces advertisement refreshes from joins and quits into one announceServer per interval
+class ServerAnnouncer
+{
+private:
+	bool dirty;
+	unsigned long long interval;
+	unsigned long long lastAnnounce;
+	unsigned long long announceCount;
+	unsigned long long requestCount;
+
+	std::string pingResponse;
+
+public:
+	ServerAnnouncer();
+
+	void setInterval(unsigned long long millis);
+	void markDirty();
+
+	bool update(RakNetInstance *raknet, const std::string &name, unsigned long long nowMillis);
+	void announce(RakNetInstance *raknet, const std::string &name, unsigned long long nowMillis);
+
+	// the bytes RakNet answers unconnected pings with, as of the last announce
+	const std::string &getPingResponse() const;
+
+	unsigned long long getAnnounceCount() const;
+	unsigned long long getRequestCount() const;
+};
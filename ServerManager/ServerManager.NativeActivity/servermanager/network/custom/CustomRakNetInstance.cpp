@@ -12,6 +12,7 @@ void CustomRakNetInstance::_startupIfNeeded(RakNetInstance *real, unsigned short
 void(*CustomRakNetInstance::host_real)(RakNetInstance *real, const std::string &name, int port, int connections);
 void CustomRakNetInstance::host(RakNetInstance *real, const std::string &name, int port, int connections)
 {
+	ServerManager::getServer()->setRakNetInstance(real);
 	host_real(real, name, ServerManager::getPort(), ServerManager::getMaxPlayers());
 }
 
@@ -12,7 +12,11 @@
 #include "../../event/player/PlayerChatEvent.h"
 #include "../../event/player/PlayerCommandPreprocessEvent.h"
 #include "../../event/player/PlayerAnimationEvent.h"
+#include "../../event/player/PlayerInteractEvent.h"
+#include "../../event/player/PlayerMoveEvent.h"
+#include "../../event/HandlerList.h"
 #include "../../event/block/SignChangeEvent.h"
+#include "../../level/PlayerSaveQueue.h"
 #include "../../plugin/PluginManager.h"
 #include "../../util/SMUtil.h"
 #include "minecraftpe/block/Block.h"
@@ -42,31 +46,37 @@
 void(*CustomServerNetworkHandler::onDisconnect_real)(ServerNetworkHandler *real, const RakNet::RakNetGUID &guid, const std::string &message);
 void CustomServerNetworkHandler::onDisconnect(ServerNetworkHandler *real, const RakNet::RakNetGUID &guid, const std::string &message)
 {
-	for (SMPlayer *player : ServerManager::getOnlinePlayers())
-	{
-		if (player->getHandle()->guid == guid)
-		{
-			real->level->getLevelStorage()->save(*player->getHandle());
+	ServerManager::getServer()->getPacketLimiter()->remove(guid.g);
+	ServerManager::getServer()->getLoginQueue()->remove(guid);
 
-			PlayerQuitEvent quitEvent(player, "§e%multiplayer.player.left", { player->getName() });
-			ServerManager::getPluginManager()->callEvent(quitEvent);
+	SMPlayer *player = ServerManager::getServer()->getPlayer(guid);
+	if (!player)
+		return;
 
-			TextPacket pk;
-			pk.type = TextPacket::TYPE_TRANSLATION;
-			pk.message = quitEvent.getQuitMessage();
-			pk.params = quitEvent.getQuitParams();
-			real->sender->send(pk);
+	ServerManager::getServer()->getPlayerSaveQueue()->snapshot(real->level->getLevelStorage(), *player->getHandle(), SMUtil::toLower(player->getName()));
 
-			ServerManager::getServer()->removePlayer(player);
+	TextPacket pk;
+	pk.type = TextPacket::TYPE_TRANSLATION;
+	pk.message = "§e%multiplayer.player.left";
+	pk.params = { player->getName() };
 
-			ServerPlayer *serverPlayer = (ServerPlayer *)player->getHandle();
-			serverPlayer->disconnect();
-			serverPlayer->remove();
+	if (PlayerQuitEvent::getHandlerList()->hasListeners())
+	{
+		PlayerQuitEvent quitEvent(player, pk.message, pk.params);
+		ServerManager::getPluginManager()->callEvent(quitEvent);
 
-			real->raknet->announceServer(ServerManager::getServerName());
-			break;
-		}
+		pk.message = quitEvent.getQuitMessage();
+		pk.params = quitEvent.getQuitParams();
 	}
+	real->sender->send(pk);
+
+	ServerManager::getServer()->removePlayer(player);
+
+	ServerPlayer *serverPlayer = (ServerPlayer *)player->getHandle();
+	serverPlayer->disconnect();
+	serverPlayer->remove();
+
+	ServerManager::getServer()->getAnnouncer()->markDirty();
 }
 
 void(*CustomServerNetworkHandler::disconnectClient_real)(ServerNetworkHandler *real, const RakNet::RakNetGUID &guid, const std::string &message);
@@ -84,6 +94,19 @@ bool CustomServerNetworkHandler::allowIncomingPacketId(ServerNetworkHandler *rea
 {
 	if (packetId == 6)
 		real->_displayGameMessage("Server", "BlockLauncher client"); // BlockLauncher, enable scripts, please and thank you
+
+	switch (ServerManager::getServer()->getPacketLimiter()->check(guid.g, packetId, PacketRateLimiter::currentMillis()))
+	{
+	case PacketRateLimiter::DROP:
+		return false;
+	case PacketRateLimiter::KICK:
+		disconnectClient(real, guid, "Sending packets too fast");
+		// the kick alone leaves the connection up, and the flood would go on against a fresh budget
+		real->raknet->getPeer()->CloseConnection(guid, true);
+		return false;
+	default:
+		break;
+	}
 	return allowIncomingPacketId_real(real, guid, packetId);
 }
 
@@ -104,15 +127,38 @@ void CustomServerNetworkHandler::handleLogin(ServerNetworkHandler *real, const R
 		return;
 	}
 
+	LoginQueue *loginQueue = ServerManager::getServer()->getLoginQueue();
+	if (loginQueue->isPending(guid))
+		return;
+
+	const char *ipAddress = real->raknet->getPeer()->GetSystemAddressFromGuid(guid).ToString(false);
+	if (!loginQueue->allowAddress(ipAddress, PacketRateLimiter::currentMillis()))
+	{
+		disconnectClient(real, guid, "Too many login attempts, please wait a moment");
+		return;
+	}
+
+	// the join itself is run from Server::tick, a few players at a time
+	loginQueue->enqueue(real, &processLogin, guid, *packet, ServerManager::getServer()->getSkinValidator());
+}
+
+void CustomServerNetworkHandler::processLogin(ServerNetworkHandler *real, const RakNet::RakNetGUID &guid, LoginPacket *packet, bool validSkin)
+{
+	if (!real->visible || real->_getPlayer(guid))
+		return;
+
 	std::string username = packet->username;
 	const char *ipAddress = real->raknet->getPeer()->GetSystemAddressFromGuid(guid).ToString(false);
 
-	PlayerPreLoginEvent preLoginEvent(username, ipAddress, packet->clientUUID);
-	ServerManager::getPluginManager()->callEvent(preLoginEvent);
-	if (preLoginEvent.getResult() != PlayerPreLoginEvent::ALLOWED)
+	if (PlayerPreLoginEvent::getHandlerList()->hasListeners())
 	{
-		disconnectClient(real, guid, preLoginEvent.getKickMessage());
-		return;
+		PlayerPreLoginEvent preLoginEvent(username, ipAddress, packet->clientUUID);
+		ServerManager::getPluginManager()->callEvent(preLoginEvent);
+		if (preLoginEvent.getResult() != PlayerPreLoginEvent::ALLOWED)
+		{
+			disconnectClient(real, guid, preLoginEvent.getKickMessage());
+			return;
+		}
 	}
 
 	bool valid = true;
@@ -133,16 +179,20 @@ void CustomServerNetworkHandler::handleLogin(ServerNetworkHandler *real, const R
 		break;
 	}
 
+	// a save left from the player's last session must reach the database before it is read back, the rest waits for tick
+	ServerManager::getServer()->getPlayerSaveQueue()->flush(real->level->getLevelStorage(), SMUtil::toLower(username));
+
 	std::unique_ptr<ServerPlayer> serverPlayer = real->createNewPlayer(guid, packet);
 	SMPlayer *smPlayer = new SMPlayer(ServerManager::getServer(), serverPlayer.get());
 
 	PlayerLoginEvent loginEvent(smPlayer, ipAddress);
+	BanEntry *ipBan = ServerManager::getBanList(BanList::IP)->matchAddress(ipAddress);
 
 	std::string iusername = SMUtil::toLower(packet->username);
 	if (!valid || !iusername.compare(SMUtil::toLower(ServerManager::getLocalPlayer()->getName())) ||
 		!iusername.compare("rcon") || !iusername.compare("console") || !iusername.compare("server"))
 		loginEvent.disallow(PlayerLoginEvent::KICK_INVALID_NAME, "disconnectionScreen.invalidName");
-	else if (packet->skin.length() != 64 * 32 * 4 && packet->skin.length() != 64 * 64 * 4)
+	else if (!validSkin)
 		loginEvent.disallow(PlayerLoginEvent::KICK_INVALID_SKIN, "disconnectionScreen.invalidSkin");
 	else if (ServerManager::getBanList(BanList::NAME)->isBanned(iusername))
 	{
@@ -151,11 +201,8 @@ void CustomServerNetworkHandler::handleLogin(ServerNetworkHandler *real, const R
 	}
 	else if (ServerManager::hasWhitelist() && !ServerManager::isWhitelisted(iusername))
 		loginEvent.disallow(PlayerLoginEvent::KICK_WHITELIST, "You are not white-listed on this server!");
-	else if (ServerManager::getBanList(BanList::IP)->isBanned(ipAddress))
-	{
-		BanEntry *entry = ServerManager::getBanList(BanList::IP)->getBanEntry(ipAddress);
-		loginEvent.disallow(PlayerLoginEvent::KICK_BANNED, "Your IP address is banned from this server! Reason: " + entry->getReason());
-	}
+	else if (ipBan)
+		loginEvent.disallow(PlayerLoginEvent::KICK_BANNED, "Your IP address is banned from this server! Reason: " + ipBan->getReason());
 
 	ServerManager::getPluginManager()->callEvent(loginEvent);
 	if (loginEvent.getResult() != PlayerLoginEvent::ALLOWED)
@@ -165,16 +212,9 @@ void CustomServerNetworkHandler::handleLogin(ServerNetworkHandler *real, const R
 		return;
 	}
 
-	std::vector<SMPlayer *> players = ServerManager::getOnlinePlayers();
-	for (int i = 0; i < players.size(); ++i)
-	{
-		SMPlayer *p = players[i];
-		if (!SMUtil::toLower(p->getName()).compare(iusername))
-		{
-			disconnectClient(real, p->getHandle()->guid, "You logged in from another location");
-			break;
-		}
-	}
+	SMPlayer *loggedIn = ServerManager::getPlayerExact(iusername);
+	if (loggedIn)
+		disconnectClient(real, loggedIn->getHandle()->guid, "You logged in from another location");
 
 	PlayStatusPacket pk;
 	pk.status = PlayStatusPacket::LOGIN_SUCCESS;
@@ -192,12 +232,15 @@ void CustomServerNetworkHandler::handleLogin(ServerNetworkHandler *real, const R
 	real->_sendAdditionalLevelData(player, guid);
 	ServerManager::getServer()->addPlayer(smPlayer);
 
-	real->raknet->announceServer(ServerManager::getServerName());
+	ServerManager::getServer()->getAnnouncer()->markDirty();
 
 	smPlayer->setAddress(real->raknet->getPeer()->GetSystemAddressFromGuid(guid).ToString(false));
 
-	PlayerJoinEvent joinEvent(smPlayer, "");
-	ServerManager::getPluginManager()->callEvent(joinEvent);
+	if (PlayerJoinEvent::getHandlerList()->hasListeners())
+	{
+		PlayerJoinEvent joinEvent(smPlayer, "");
+		ServerManager::getPluginManager()->callEvent(joinEvent);
+	}
 }
 
 void(*CustomServerNetworkHandler::handleSetTime_real)(ServerNetworkHandler *real, const RakNet::RakNetGUID &guid, SetTimePacket *packet);
@@ -210,7 +253,7 @@ void(*CustomServerNetworkHandler::handleText_real)(ServerNetworkHandler *real, c
 void CustomServerNetworkHandler::handleText(ServerNetworkHandler *real, const RakNet::RakNetGUID &guid, TextPacket *packet)
 {
 	Player *player = real->_getPlayer(guid);
-	if (!player->isAlive() || packet->type != TextPacket::TYPE_CHAT)
+	if (!player || !player->isAlive() || packet->type != TextPacket::TYPE_CHAT)
 		return;
 
 	std::string message = packet->message;
@@ -220,24 +263,34 @@ void CustomServerNetworkHandler::handleText(ServerNetworkHandler *real, const Ra
 	SMPlayer *smPlayer = ServerManager::getServer()->getPlayer(player);
 	if (message[0] == '#')
 	{
-		PlayerCommandPreprocessEvent event(smPlayer, message);
-		ServerManager::getPluginManager()->callEvent(event);
+		if (PlayerCommandPreprocessEvent::getHandlerList()->hasListeners())
+		{
+			PlayerCommandPreprocessEvent event(smPlayer, message);
+			ServerManager::getPluginManager()->callEvent(event);
 
-		if (event.isCancelled())
-			return;
+			if (event.isCancelled())
+				return;
 
-		message = event.getMessage();
-		ServerManager::dispatchCommand(event.getPlayer(), message.erase(0, 1));
+			smPlayer = event.getPlayer();
+			message = event.getMessage();
+		}
+		ServerManager::dispatchCommand(smPlayer, message.erase(0, 1));
 	}
 	else
 	{
-		PlayerChatEvent event(smPlayer, message);
-		ServerManager::getPluginManager()->callEvent(event);
+		if (PlayerChatEvent::getHandlerList()->hasListeners())
+		{
+			PlayerChatEvent event(smPlayer, message);
+			ServerManager::getPluginManager()->callEvent(event);
 
-		if (event.isCancelled())
-			return;
+			if (event.isCancelled())
+				return;
+
+			message = SMUtil::format(event.getFormat().c_str(), event.getPlayer()->getDisplayName().c_str(), event.getMessage().c_str());
+		}
+		else
+			message = SMUtil::format(PlayerChatEvent::DEFAULT_FORMAT, smPlayer->getDisplayName().c_str(), message.c_str());
 
-		message = SMUtil::format(event.getFormat().c_str(), event.getPlayer()->getDisplayName().c_str(), event.getMessage().c_str());
 		ServerManager::broadcastMessage(message);
 	}
 }
@@ -257,37 +310,45 @@ void CustomServerNetworkHandler::handleMovePlayer(ServerNetworkHandler *real, co
 
 	SMPlayer *smPlayer = ServerManager::getServer()->getPlayer(player);
 
-	Location from(smPlayer->getRegion(), player->lastPos, player->lastRotation);
-	Location to = smPlayer->getLocation();
+	// resets carry respawns and corrections, so they are never filtered
+	if (!ServerManager::getServer()->getMovementFilter()->accept(smPlayer->movementState, packet->pos.x, packet->pos.y, packet->pos.z,
+		packet->rot.x, packet->rot.y, packet->yaw, packet->mode == MovePlayerPacket::RESET))
+		return;
 
-	to.setPos(packet->pos);
-	to.setRotation(packet->rot);
+	if (PlayerMoveEvent::getHandlerList()->hasListeners())
+	{
+		Location from(smPlayer->getRegion(), player->lastPos, player->lastRotation);
+		Location to = smPlayer->getLocation();
 
-	PlayerMoveEvent event(smPlayer, from, to);
-	ServerManager::getPluginManager()->callEvent(event);
+		to.setPos(packet->pos);
+		to.setRotation(packet->rot);
 
-	if (event.isCancelled())
-	{
-		from.setY(from.getY() + 1.62f);
-
-		MovePlayerPacket pk;
-		pk.uniqueID = player->getUniqueID();
-		pk.pos = from.getPos();
-		pk.rot = from.getRotation();
-		pk.yaw = from.getRotation().y;
-		pk.mode = MovePlayerPacket::RESET;
-		pk.onGround = false;
-		real->sender->send(player->guid, pk);
-		return;
-	}
+		PlayerMoveEvent event(smPlayer, from, to);
+		ServerManager::getPluginManager()->callEvent(event);
 
-	if (!to.equals(event.getTo()) && !event.isCancelled())
-	{
-		smPlayer->teleport(event.getTo(), PlayerTeleportEvent::UNKNOWN);
-		return;
+		if (event.isCancelled())
+		{
+			from.setY(from.getY() + 1.62f);
+
+			MovePlayerPacket pk;
+			pk.uniqueID = player->getUniqueID();
+			pk.pos = from.getPos();
+			pk.rot = from.getRotation();
+			pk.yaw = from.getRotation().y;
+			pk.mode = MovePlayerPacket::RESET;
+			pk.onGround = false;
+			real->sender->send(player->guid, pk);
+			return;
+		}
+
+		if (!to.equals(event.getTo()))
+		{
+			smPlayer->teleport(event.getTo(), PlayerTeleportEvent::UNKNOWN);
+			return;
+		}
 	}
 
-	if (!from.equals(smPlayer->getLocation()) && smPlayer->justTeleported)
+	if (smPlayer->justTeleported && !Location(smPlayer->getRegion(), player->lastPos, player->lastRotation).equals(smPlayer->getLocation()))
 	{
 		smPlayer->justTeleported = false;
 		return;
@@ -328,7 +389,10 @@ void CustomServerNetworkHandler::handleMovePlayer(ServerNetworkHandler *real, co
 
 		player->tick(*player->getRegion());
 	}
-	player->getRegion()->getDimension()->sendBroadcast(*packet, player);
+
+	// only players within view distance get every update, the rest are down-sampled
+	if (!ServerManager::getServer()->relayMovement(smPlayer, *packet))
+		player->getRegion()->getDimension()->sendBroadcast(*packet, player);
 }
 
 void(*CustomServerNetworkHandler::handleRemoveBlock_real)(ServerNetworkHandler *real, const RakNet::RakNetGUID &guid, RemoveBlockPacket *packet);
@@ -393,9 +457,14 @@ void CustomServerNetworkHandler::handleUseItem(ServerNetworkHandler *real, const
 
 	if (packet->face == 255)
 	{
-		std::unique_ptr<PlayerInteractEvent> event = EventFactory::callPlayerInteractEvent(player, Action::RIGHT_CLICK_AIR, &packet->item);
-		if (event && event->useItemInHand() != Event::DENY)
+		if (!PlayerInteractEvent::getHandlerList()->hasListeners())
 			real->gamemode->useItem(*player, packet->item);
+		else
+		{
+			std::unique_ptr<PlayerInteractEvent> event = EventFactory::callPlayerInteractEvent(player, Action::RIGHT_CLICK_AIR, &packet->item);
+			if (event && event->useItemInHand() != Event::DENY)
+				real->gamemode->useItem(*player, packet->item);
+		}
 	}
 	else
 	{
@@ -512,11 +581,14 @@ void CustomServerNetworkHandler::handleAnimate(ServerNetworkHandler *real, const
 	if (smPlayer->isLocalPlayer())
 		return;
 
-	PlayerAnimationEvent event(smPlayer, (PlayerAnimationType)packet->action);
-	ServerManager::getPluginManager()->callEvent(event);
+	if (PlayerAnimationEvent::getHandlerList()->hasListeners())
+	{
+		PlayerAnimationEvent event(smPlayer, (PlayerAnimationType)packet->action);
+		ServerManager::getPluginManager()->callEvent(event);
 
-	if (event.isCancelled())
-		return;
+		if (event.isCancelled())
+			return;
+	}
 
 	handleAnimate_real(real, guid, packet);
 }
@@ -538,19 +610,21 @@ void CustomServerNetworkHandler::handleBlockEntityData(ServerNetworkHandler *rea
 
 	if (BlockEntity::isType(*blockEntity, BlockEntityType::SIGN) && !packet->dataTag.getString("id").compare("Sign"))
 	{
-		SignChangeEvent event(player->getRegion()->getBlock(packet->pos), smPlayer, {
-			packet->dataTag.getString("Text1"),
-			packet->dataTag.getString("Text2"),
-			packet->dataTag.getString("Text3"),
-			packet->dataTag.getString("Text4")
-		});
-		ServerManager::getPluginManager()->callEvent(event);
-
-		if (!event.isCancelled())
+		if (SignChangeEvent::getHandlerList()->hasListeners())
 		{
-			blockEntity->onUpdatePacket(packet->dataTag);
-			player->getRegion()->getDimension()->sendBroadcast(*packet, player);
+			SignChangeEvent event(player->getRegion()->getBlock(packet->pos), smPlayer, {
+				packet->dataTag.getString("Text1"),
+				packet->dataTag.getString("Text2"),
+				packet->dataTag.getString("Text3"),
+				packet->dataTag.getString("Text4")
+			});
+			ServerManager::getPluginManager()->callEvent(event);
+
+			if (event.isCancelled())
+				return;
 		}
+		blockEntity->onUpdatePacket(packet->dataTag);
+		player->getRegion()->getDimension()->sendBroadcast(*packet, player);
 	}
 }
 
@@ -570,7 +644,7 @@ void(*CustomServerNetworkHandler::allowIncomingConnections_real)(ServerNetworkHa
 void CustomServerNetworkHandler::allowIncomingConnections(ServerNetworkHandler *real, const std::string &name, bool visible)
 {
 	real->visible = true;
-	real->raknet->announceServer(ServerManager::getServer()->getServerName());
+	ServerManager::getServer()->getAnnouncer()->announce(real->raknet, ServerManager::getServerName(), PacketRateLimiter::currentMillis());
 }
 
 void CustomServerNetworkHandler::setupHooks()
@@ -43,6 +43,7 @@ public:
 
 	static void(*handleLogin_real)(ServerNetworkHandler *, const RakNet::RakNetGUID &, LoginPacket *);
 	static void handleLogin(ServerNetworkHandler *, const RakNet::RakNetGUID &, LoginPacket *);
+	static void processLogin(ServerNetworkHandler *, const RakNet::RakNetGUID &, LoginPacket *, bool);
 
 	static void (*handleSetTime_real)(ServerNetworkHandler *, const RakNet::RakNetGUID &, SetTimePacket *);
 	static void handleSetTime(ServerNetworkHandler *, const RakNet::RakNetGUID &, SetTimePacket *);
@@ -0,0 +1,103 @@
+#include <time.h>
+
+#include "ListenerTimings.h"
+
+std::atomic<bool> ListenerTimings::enabled(false);
+std::atomic<int> ListenerTimings::nextThreadSlot(0);
+
+ListenerTimings::ListenerTimings()
+{
+	reset();
+}
+
+bool ListenerTimings::isEnabled()
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void ListenerTimings::setEnabled(bool value)
+{
+	enabled.store(value, std::memory_order_relaxed);
+}
+
+unsigned long long ListenerTimings::now()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void ListenerTimings::record(unsigned long long nanos)
+{
+	Slot &slot = slots[getThreadSlot()];
+
+	slot.count.fetch_add(1, std::memory_order_relaxed);
+	slot.totalNanos.fetch_add(nanos, std::memory_order_relaxed);
+	slot.histogram[getBucket(nanos)].fetch_add(1, std::memory_order_relaxed);
+
+	unsigned long long max = slot.maxNanos.load(std::memory_order_relaxed);
+	while(nanos > max && !slot.maxNanos.compare_exchange_weak(max, nanos, std::memory_order_relaxed))
+		;
+}
+
+void ListenerTimings::reset()
+{
+	for(Slot &slot : slots)
+	{
+		slot.count.store(0, std::memory_order_relaxed);
+		slot.totalNanos.store(0, std::memory_order_relaxed);
+		slot.maxNanos.store(0, std::memory_order_relaxed);
+		for(std::atomic<unsigned int> &bucket : slot.histogram)
+			bucket.store(0, std::memory_order_relaxed);
+	}
+}
+
+ListenerTimings::Snapshot ListenerTimings::getSnapshot() const
+{
+	Snapshot snapshot = {0, 0, 0, 0};
+	unsigned long long histogram[HISTOGRAM_BUCKETS] = {0};
+
+	for(const Slot &slot : slots)
+	{
+		snapshot.count += slot.count.load(std::memory_order_relaxed);
+		snapshot.totalNanos += slot.totalNanos.load(std::memory_order_relaxed);
+
+		unsigned long long max = slot.maxNanos.load(std::memory_order_relaxed);
+		if(max > snapshot.maxNanos)
+			snapshot.maxNanos = max;
+
+		for(int i = 0; i < HISTOGRAM_BUCKETS; ++i)
+			histogram[i] += slot.histogram[i].load(std::memory_order_relaxed);
+	}
+
+	// p99 is reported as the upper bound of the power-of-two bucket holding the 99th percentile
+	unsigned long long threshold = (snapshot.count * 99 + 99) / 100;
+	unsigned long long seen = 0;
+	for(int i = 0; i < HISTOGRAM_BUCKETS && snapshot.count > 0; ++i)
+	{
+		seen += histogram[i];
+		if(seen >= threshold)
+		{
+			snapshot.p99Nanos = 1ULL << i;
+			break;
+		}
+	}
+	if(snapshot.p99Nanos > snapshot.maxNanos)
+		snapshot.p99Nanos = snapshot.maxNanos;
+
+	return snapshot;
+}
+
+int ListenerTimings::getThreadSlot()
+{
+	static thread_local int slot = nextThreadSlot.fetch_add(1, std::memory_order_relaxed) % MAX_THREAD_SLOTS;
+	return slot;
+}
+
+int ListenerTimings::getBucket(unsigned long long nanos)
+{
+	int bucket = 0;
+	while(bucket < HISTOGRAM_BUCKETS - 1 && (1ULL << bucket) < nanos)
+		++bucket;
+	return bucket;
+}
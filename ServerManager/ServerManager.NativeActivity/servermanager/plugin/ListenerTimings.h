@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+
+class ListenerTimings
+{
+public:
+	struct Snapshot
+	{
+		unsigned long long count;
+		unsigned long long totalNanos;
+		unsigned long long maxNanos;
+		unsigned long long p99Nanos;
+	};
+
+	static const int MAX_THREAD_SLOTS = 4;
+	static const int HISTOGRAM_BUCKETS = 40;
+
+private:
+	// each thread writes to its own slot, so the counters are never contended on the game thread
+	struct Slot
+	{
+		std::atomic<unsigned long long> count;
+		std::atomic<unsigned long long> totalNanos;
+		std::atomic<unsigned long long> maxNanos;
+		std::atomic<unsigned int> histogram[HISTOGRAM_BUCKETS];
+	};
+
+	Slot slots[MAX_THREAD_SLOTS];
+
+	static std::atomic<bool> enabled;
+	static std::atomic<int> nextThreadSlot;
+
+public:
+	ListenerTimings();
+
+	static bool isEnabled();
+	static void setEnabled(bool value);
+
+	static unsigned long long now();
+
+	void record(unsigned long long nanos);
+	void reset();
+
+	Snapshot getSnapshot() const;
+
+private:
+	static int getThreadSlot();
+	static int getBucket(unsigned long long nanos);
+};
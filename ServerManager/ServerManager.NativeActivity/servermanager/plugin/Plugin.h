@@ -1,11 +1,12 @@
 #pragma once
 
 #include "../command/CommandExecutor.h"
+#include "../command/AsyncCommandExecutor.h"
 
 class Server;
 class PluginDescriptionFile;
 
-class Plugin : public CommandExecutor
+class Plugin : public CommandExecutor, public AsyncCommandExecutor
 {
 public:
 	virtual std::string getDataFolder() = 0;
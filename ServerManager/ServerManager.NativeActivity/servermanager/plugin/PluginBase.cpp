@@ -100,6 +100,11 @@ bool PluginBase::onCommand(SMPlayer *sender, Command *command, std::string &labe
 	return false;
 }
 
+bool PluginBase::onAsyncCommand(AsyncCommand &command)
+{
+	return false;
+}
+
 PluginCommand *PluginBase::getCommand(std::string &name)
 {
 	std::string alias = SMUtil::toLower(name);
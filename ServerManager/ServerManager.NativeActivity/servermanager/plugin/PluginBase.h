@@ -41,6 +41,7 @@ public:
 	void init(Server *server, PluginDescriptionFile *description, const std::string &dataFolder);
 
 	bool onCommand(SMPlayer *sender, Command *command, std::string &label, std::vector<std::string> &args);
+	bool onAsyncCommand(AsyncCommand &command);
 
 	PluginCommand *getCommand(std::string &name);
 };
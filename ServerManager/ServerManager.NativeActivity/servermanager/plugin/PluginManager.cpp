@@ -4,6 +4,8 @@
 #include "../Server.h"
 #include "../command/CommandMap.h"
 #include "../command/PluginCommand.h"
+#include "../command/AsyncCommandRunner.h"
+#include "../scheduler/Scheduler.h"
 #include "PluginBase.h"
 #include "RegisteredListener.h"
 #include "PluginDescriptionFile.h"
@@ -264,13 +266,15 @@ std::vector<Command *> PluginManager::parseJsonCommands(Plugin *plugin)
 		if(it.first.find(':') != std::string::npos)
 			continue;
 
-		Command *newCmd = new PluginCommand(it.first, plugin);
+		PluginCommand *newCmd = new PluginCommand(it.first, plugin);
 		PluginDescriptionFile::CommandDescValue description = it.second["description"];
 		PluginDescriptionFile::CommandDescValue usage = it.second["usage"];
 		PluginDescriptionFile::CommandDescValue aliases = it.second["aliases"];
+		PluginDescriptionFile::CommandDescValue async = it.second["async"];
 
 		newCmd->setDescription(description.strValue);
 		newCmd->setUsage(usage.strValue);
+		newCmd->setAsync(!async.isArray && !async.strValue.compare("true"));
 
 		std::vector<std::string> aliasList;
 		if(aliases.isArray)
@@ -310,6 +314,9 @@ void PluginManager::disablePlugin(Plugin *plugin)
 	PluginDisableEvent disableEvent(plugin);
 	server->getPluginManager()->callEvent(disableEvent);
 
+	server->getAsyncCommandRunner()->cancel(plugin);
+	server->getScheduler()->cancelTasks(plugin);
+
 	((PluginBase *)plugin)->setEnabled(false);
 
 	HandlerList::unregisterAll(plugin);
@@ -329,16 +336,7 @@ void PluginManager::clearPlugins()
 
 void PluginManager::callEvent(Event &event)
 {
-	HandlerList *handlers = event.getHandlers();
-	std::vector<RegisteredListener *> listeners = handlers->getRegisteredListeners();
-
-	for (RegisteredListener *registration : listeners)
-	{
-		if (!registration->getPlugin()->isEnabled())
-			continue;
-
-		registration->callEvent(event);
-	}
+	event.getHandlers()->callEvent(event);
 }
 
 void PluginManager::registerEvent(EventType type, Listener *listener, std::function<void(Listener *, Event &)> func, Plugin *plugin, EventPriority priority, bool ignoreCancelled)
@@ -346,14 +344,21 @@ void PluginManager::registerEvent(EventType type, Listener *listener, std::funct
 	if(!plugin->isEnabled())
 		return;
 
-	auto executor = [func](Listener *listener, Event &event)
-	{
-		func(listener, event);
-	};
-
 	HandlerList *handlerList = getEventListeners(type);
 	if(handlerList)
-		handlerList->registerListener(new RegisteredListener(listener, executor, priority, plugin, ignoreCancelled));
+		handlerList->registerListener(new RegisteredListener(listener, type, func, priority, plugin, ignoreCancelled));
+}
+
+bool PluginManager::hasListeners(EventType type)
+{
+	HandlerList *handlerList = getEventListeners(type);
+	return handlerList && handlerList->hasListeners();
+}
+
+unsigned int PluginManager::getSkippedEventCount(EventType type)
+{
+	HandlerList *handlerList = getEventListeners(type);
+	return handlerList ? handlerList->getSkippedCount() : 0;
 }
 
 #include "../event/player/PlayerJoinEvent.h"
@@ -56,6 +56,9 @@ public:
 	void callEvent(Event &event);
 	void registerEvent(EventType type, Listener *listener, std::function<void(Listener *, Event &)> func, Plugin *plugin, EventPriority priority = EventPriority::NORMAL, bool ignoreCancelled = false);
 
+	bool hasListeners(EventType type);
+	unsigned int getSkippedEventCount(EventType type);
+
 private:
 	HandlerList *getEventListeners(EventType type);
 };
@@ -2,13 +2,15 @@
 #include "../event/Event.h"
 #include "../event/Cancellable.h"
 
-RegisteredListener::RegisteredListener(Listener *listener, EventExecutor executor, EventPriority priority, Plugin *plugin, bool ignoreCancelled)
+RegisteredListener::RegisteredListener(Listener *listener, EventType type, EventExecutor executor, EventPriority priority, Plugin *plugin, bool ignoreCancelled)
 {
 	this->listener = listener;
+	this->type = type;
 	this->priority = priority;
 	this->plugin = plugin;
 	this->executor = executor;
 	this->ignoreCancelled = ignoreCancelled;
+	this->unregistered = false;
 }
 
 Listener *RegisteredListener::getListener() const
@@ -21,6 +23,11 @@ Plugin *RegisteredListener::getPlugin() const
 	return plugin;
 }
 
+EventType RegisteredListener::getEventType() const
+{
+	return type;
+}
+
 EventPriority RegisteredListener::getPriority() const
 {
 	return priority;
@@ -31,10 +38,38 @@ bool RegisteredListener::isIgnoringCancelled() const
 	return ignoreCancelled;
 }
 
+const EventExecutor &RegisteredListener::getExecutor() const
+{
+	return executor;
+}
+
+bool RegisteredListener::isUnregistered() const
+{
+	return unregistered;
+}
+
+void RegisteredListener::setUnregistered()
+{
+	unregistered = true;
+}
+
+ListenerTimings &RegisteredListener::getTimings()
+{
+	return timings;
+}
+
 void RegisteredListener::callEvent(Event &event)
 {
 	if(event.isCancellable() && ((Cancellable &)event).isCancelled() && isIgnoringCancelled())
 		return;
 
+	if(!ListenerTimings::isEnabled())
+	{
+		executor(listener, event);
+		return;
+	}
+
+	unsigned long long start = ListenerTimings::now();
 	executor(listener, event);
+	timings.record(ListenerTimings::now() - start);
 }
@@ -3,7 +3,9 @@
 #include <memory>
 
 #include "../event/EventPriority.h"
+#include "../event/EventType.h"
 #include "../event/EventExecutor.h"
+#include "ListenerTimings.h"
 
 class Listener;
 class Plugin;
@@ -13,18 +15,29 @@ class RegisteredListener
 {
 private:
 	Listener *listener;
+	EventType type;
 	EventPriority priority;
 	Plugin *plugin;
 	EventExecutor executor;
 	bool ignoreCancelled;
+	bool unregistered;
+	ListenerTimings timings;
 
 public:
-	RegisteredListener(Listener *listener, EventExecutor executor, EventPriority priority, Plugin *plugin, bool ignoreCancelled);
+	RegisteredListener(Listener *listener, EventType type, EventExecutor executor, EventPriority priority, Plugin *plugin, bool ignoreCancelled);
 
 	Listener *getListener() const;
 	Plugin *getPlugin() const;
+	EventType getEventType() const;
 	EventPriority getPriority() const;
 	bool isIgnoringCancelled() const;
+	const EventExecutor &getExecutor() const;
+
+	// set once it is removed from its HandlerList, a dispatch still walking the baked array skips it
+	bool isUnregistered() const;
+	void setUnregistered();
+
+	ListenerTimings &getTimings();
 
 	void callEvent(Event &event);
 };
@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <chrono>
+
+#include "Scheduler.h"
+#include "../plugin/Plugin.h"
+#include "../util/ThreadPool.h"
+
+Scheduler::Scheduler(ThreadPool *pool)
+{
+	this->pool = pool;
+
+	wheel.resize(WHEEL_SIZE);
+	currentTick = 0;
+	tickBudget = 0;
+	nextId = 1;
+}
+
+Scheduler::~Scheduler()
+{
+	// cancelled tasks have already left the map, they are only unlinked from the wheel when their slot comes up,
+	// so they are freed while every live task is still there to be read
+	for(std::vector<Task *> &slot : wheel)
+	{
+		for(Task *task : slot)
+		{
+			if(task->cancelled)
+				delete task;
+		}
+	}
+
+	for(Task *task : ready)
+	{
+		if(task->cancelled)
+			delete task;
+	}
+
+	// the pool is stopped first, so all async work has ended up here
+	for(std::shared_ptr<AsyncTask> &asyncTask : asyncFinished)
+	{
+		if(asyncTask->task->cancelled)
+			delete asyncTask->task;
+	}
+
+	for(auto &it : tasks)
+		delete it.second;
+}
+
+int Scheduler::runTask(Plugin *plugin, const Callback &task)
+{
+	return schedule(plugin, task, 1, 0);
+}
+
+int Scheduler::runTaskLater(Plugin *plugin, const Callback &task, int delay)
+{
+	return schedule(plugin, task, delay, 0);
+}
+
+int Scheduler::runTaskTimer(Plugin *plugin, const Callback &task, int delay, int period)
+{
+	return schedule(plugin, task, delay, std::max(period, 1));
+}
+
+int Scheduler::runTaskAsync(Plugin *plugin, const Callback &work, const Callback &completion)
+{
+	if(!plugin || !plugin->isEnabled())
+		return -1;
+
+	Task *task = new Task;
+	task->id = nextId++;
+	task->plugin = plugin;
+	task->callback = completion;
+	task->period = 0;
+	task->rounds = 0;
+	task->cancelled = false;
+	tasks[task->id] = task;
+
+	std::shared_ptr<AsyncTask> asyncTask = std::make_shared<AsyncTask>();
+	asyncTask->task = task;
+	asyncTask->plugin = plugin;
+	asyncTask->work = work;
+	asyncTask->abandoned = false;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		asyncPending.push_back(asyncTask);
+	}
+	pool->submit([this, asyncTask] { runAsync(asyncTask); }, ThreadPool::LOW);
+	return task->id;
+}
+
+void Scheduler::cancelTask(int id)
+{
+	auto it = tasks.find(id);
+	if(it == tasks.end())
+		return;
+
+	Task *task = it->second;
+	task->cancelled = true;
+	tasks.erase(it);
+
+	abandon(NULL, task);
+}
+
+void Scheduler::cancelTasks(Plugin *plugin)
+{
+	for(auto it = tasks.begin(); it != tasks.end();)
+	{
+		if(it->second->plugin == plugin)
+		{
+			it->second->cancelled = true;
+			it = tasks.erase(it);
+		}
+		else
+			++it;
+	}
+
+	abandon(plugin, NULL);
+
+	// work already running may still call into the plugin, it has to finish before the plugin goes away
+	std::unique_lock<std::mutex> lock(mutex);
+	idle.wait(lock, [this, plugin] {
+		return std::find(asyncRunning.begin(), asyncRunning.end(), plugin) == asyncRunning.end();
+	});
+}
+
+bool Scheduler::isQueued(int id) const
+{
+	return tasks.find(id) != tasks.end();
+}
+
+void Scheduler::setTickBudget(int micros)
+{
+	tickBudget = micros > 0 ? micros * 1000ULL : 0;
+}
+
+void Scheduler::tick()
+{
+	std::deque<std::shared_ptr<AsyncTask>> finished;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		finished.swap(asyncFinished);
+	}
+
+	// finished async work makes its completion due right away
+	for(std::shared_ptr<AsyncTask> &asyncTask : finished)
+	{
+		if(asyncTask->task->cancelled)
+			release(asyncTask->task);
+		else
+			ready.push_back(asyncTask->task);
+	}
+
+	++currentTick;
+	std::vector<Task *> &slot = wheel[currentTick & (WHEEL_SIZE - 1)];
+	for(size_t i = 0; i < slot.size();)
+	{
+		Task *task = slot[i];
+		if(!task->cancelled && task->rounds > 0)
+		{
+			--task->rounds;
+			++i;
+			continue;
+		}
+
+		slot[i] = slot.back();
+		slot.pop_back();
+
+		if(task->cancelled)
+			release(task);
+		else
+			ready.push_back(task);
+	}
+
+	unsigned long long start = tickBudget ? now() : 0;
+	while(!ready.empty())
+	{
+		if(tickBudget && now() - start >= tickBudget)
+			break;
+
+		Task *task = ready.front();
+		ready.pop_front();
+
+		if(task->cancelled || !task->plugin->isEnabled())
+		{
+			tasks.erase(task->id);
+			release(task);
+			continue;
+		}
+
+		if(task->callback)
+			task->callback();
+
+		if(task->cancelled || task->period <= 0)
+		{
+			tasks.erase(task->id);
+			release(task);
+		}
+		else
+			insert(task, task->period);
+	}
+}
+
+size_t Scheduler::getPendingTasks() const
+{
+	return tasks.size();
+}
+
+size_t Scheduler::getReadyTasks() const
+{
+	return ready.size();
+}
+
+int Scheduler::schedule(Plugin *plugin, const Callback &task, int delay, int period)
+{
+	if(!plugin || !plugin->isEnabled())
+		return -1;
+
+	Task *newTask = new Task;
+	newTask->id = nextId++;
+	newTask->plugin = plugin;
+	newTask->callback = task;
+	newTask->period = period;
+	newTask->cancelled = false;
+
+	tasks[newTask->id] = newTask;
+	insert(newTask, std::max(delay, 1));
+	return newTask->id;
+}
+
+void Scheduler::insert(Task *task, int delay)
+{
+	task->rounds = (delay - 1) / WHEEL_SIZE;
+	wheel[(currentTick + delay) & (WHEEL_SIZE - 1)].push_back(task);
+}
+
+void Scheduler::release(Task *task)
+{
+	delete task;
+}
+
+void Scheduler::runAsync(const std::shared_ptr<AsyncTask> &asyncTask)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		asyncPending.erase(std::find(asyncPending.begin(), asyncPending.end(), asyncTask));
+
+		// an abandoned task still goes back to the main thread, which owns and frees it
+		if(asyncTask->abandoned)
+		{
+			asyncFinished.push_back(asyncTask);
+			return;
+		}
+		asyncRunning.push_back(asyncTask->plugin);
+	}
+
+	if(asyncTask->work)
+		asyncTask->work();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	asyncRunning.erase(std::find(asyncRunning.begin(), asyncRunning.end(), asyncTask->plugin));
+	asyncFinished.push_back(asyncTask);
+	idle.notify_all();
+}
+
+// marks the queued async work of a plugin, or of one task, so the worker skips it
+void Scheduler::abandon(Plugin *plugin, Task *task)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	for(std::shared_ptr<AsyncTask> &asyncTask : asyncPending)
+	{
+		if(asyncTask->task == task || (plugin && asyncTask->plugin == plugin))
+			asyncTask->abandoned = true;
+	}
+}
+
+unsigned long long Scheduler::now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
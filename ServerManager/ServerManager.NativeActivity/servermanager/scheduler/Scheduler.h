@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+
+class Plugin;
+class ThreadPool;
+
+// main-thread task scheduler for plugins, timers sit on a timing wheel so scheduling and cancelling stay O(1)
+class Scheduler
+{
+public:
+	typedef std::function<void()> Callback;
+
+	static const int WHEEL_SIZE = 256;
+
+private:
+	struct Task
+	{
+		int id;
+		Plugin *plugin;
+		Callback callback;
+		int period;
+		unsigned long long rounds;
+		bool cancelled;
+	};
+
+	// the completion stays off the wheel until its work is done, the worker never touches task
+	struct AsyncTask
+	{
+		Task *task;
+		Plugin *plugin;
+		Callback work;
+		// set under the mutex, work that has not started yet is skipped
+		bool abandoned;
+	};
+
+	std::vector<std::vector<Task *>> wheel;
+	std::unordered_map<int, Task *> tasks;
+	std::deque<Task *> ready;
+	unsigned long long currentTick;
+	unsigned long long tickBudget;
+	int nextId;
+
+	ThreadPool *pool;
+	std::mutex mutex;
+	std::condition_variable idle;
+	std::vector<std::shared_ptr<AsyncTask>> asyncPending;
+	std::vector<Plugin *> asyncRunning;
+	std::deque<std::shared_ptr<AsyncTask>> asyncFinished;
+
+public:
+	Scheduler(ThreadPool *pool);
+	~Scheduler();
+
+	// all of these are for the main thread, the returned id is -1 if the plugin is not enabled
+	int runTask(Plugin *plugin, const Callback &task);
+	int runTaskLater(Plugin *plugin, const Callback &task, int delay);
+	int runTaskTimer(Plugin *plugin, const Callback &task, int delay, int period);
+	// work runs on the thread pool, completion runs on the main thread afterwards
+	int runTaskAsync(Plugin *plugin, const Callback &work, const Callback &completion);
+
+	void cancelTask(int id);
+	// also waits for async work of the plugin that is already running
+	void cancelTasks(Plugin *plugin);
+	bool isQueued(int id) const;
+
+	// microseconds of task time per tick, tasks past it wait for the next one (0 means no limit)
+	void setTickBudget(int micros);
+
+	void tick();
+
+	size_t getPendingTasks() const;
+	size_t getReadyTasks() const;
+
+private:
+	int schedule(Plugin *plugin, const Callback &task, int delay, int period);
+	void insert(Task *task, int delay);
+	void release(Task *task);
+	void runAsync(const std::shared_ptr<AsyncTask> &asyncTask);
+	void abandon(Plugin *plugin, Task *task);
+
+	static unsigned long long now();
+};
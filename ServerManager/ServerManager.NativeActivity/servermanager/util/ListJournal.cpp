@@ -0,0 +1,130 @@
+#include <fstream>
+
+#include "ListJournal.h"
+
+ListJournal::ListJournal()
+{
+	file = NULL;
+	size = 0;
+}
+
+ListJournal::~ListJournal()
+{
+	close();
+}
+
+bool ListJournal::open(const std::string &path)
+{
+	close();
+
+	this->path = path;
+
+	file = fopen(path.c_str(), "ab");
+	if(!file)
+		return false;
+
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	return true;
+}
+
+void ListJournal::close()
+{
+	if(!file)
+		return;
+
+	fclose(file);
+	file = NULL;
+	size = 0;
+}
+
+bool ListJournal::isOpen() const
+{
+	return file != NULL;
+}
+
+int ListJournal::replay(const std::function<void(char, const std::string &)> &handler) const
+{
+	return replayFile(getRotatedPath(), handler) + replayFile(path, handler);
+}
+
+void ListJournal::append(char op, const std::string &record)
+{
+	if(!file)
+		return;
+
+	fputc(op, file);
+	fwrite(record.data(), 1, record.size(), file);
+	fputc('\n', file);
+	fflush(file);
+
+	size += record.size() + 2;
+}
+
+bool ListJournal::needsCompaction() const
+{
+	return size >= COMPACT_THRESHOLD;
+}
+
+void ListJournal::rotate()
+{
+	if(!file)
+		return;
+
+	fclose(file);
+	file = NULL;
+
+	std::string rotatedPath = getRotatedPath();
+	FILE *rotated = fopen(rotatedPath.c_str(), "rb");
+	if(!rotated)
+		rename(path.c_str(), rotatedPath.c_str());
+	else
+	{
+		// an earlier compaction never finished, so its records are kept and ours go after them
+		fclose(rotated);
+
+		std::ifstream ifs(path.c_str(), std::ios::binary);
+		std::ofstream ofs(rotatedPath.c_str(), std::ios::binary | std::ios::app);
+		ofs << ifs.rdbuf();
+		ofs.close();
+		ifs.close();
+	}
+
+	file = fopen(path.c_str(), "wb");
+	size = 0;
+}
+
+void ListJournal::finishCompaction()
+{
+	::remove(getRotatedPath().c_str());
+}
+
+std::string ListJournal::getRotatedPath() const
+{
+	return path + ".old";
+}
+
+int ListJournal::replayFile(const std::string &path, const std::function<void(char, const std::string &)> &handler)
+{
+	std::ifstream ifs(path.c_str());
+	if(!ifs.is_open())
+		return 0;
+
+	int records = 0;
+	std::string line;
+	while(getline(ifs, line))
+	{
+		// a record without its newline was cut off mid-write
+		if(ifs.eof())
+			break;
+
+		if(line.size() < 2 || (line[0] != OP_ADD && line[0] != OP_REMOVE))
+			continue;
+
+		handler(line[0], line.substr(1));
+		++records;
+	}
+	ifs.close();
+
+	return records;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <cstdio>
+#include <functional>
+
+// append-only log of list changes, folded into the list's snapshot file by compaction
+class ListJournal
+{
+public:
+	static const char OP_ADD = '+';
+	static const char OP_REMOVE = '-';
+
+	static const long COMPACT_THRESHOLD = 64 * 1024;
+
+private:
+	std::string path;
+	FILE *file;
+	long size;
+
+public:
+	ListJournal();
+	~ListJournal();
+
+	bool open(const std::string &path);
+	void close();
+	bool isOpen() const;
+
+	// replays records left from an unfinished compaction first, then the live journal
+	int replay(const std::function<void(char, const std::string &)> &handler) const;
+
+	void append(char op, const std::string &record);
+	bool needsCompaction() const;
+
+	void rotate();
+	void finishCompaction();
+
+private:
+	std::string getRotatedPath() const;
+	static int replayFile(const std::string &path, const std::function<void(char, const std::string &)> &handler);
+};
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cstdio>
+#include <unistd.h>
+
+#include "PersistenceWorker.h"
+#include "ThreadPool.h"
+
+PersistenceWorker::PersistenceWorker(ThreadPool *pool)
+{
+	this->pool = pool;
+	running = false;
+	scheduled = false;
+}
+
+PersistenceWorker::~PersistenceWorker()
+{
+	stop();
+}
+
+void PersistenceWorker::start()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(running)
+			return;
+
+		running = true;
+	}
+	schedule();
+}
+
+void PersistenceWorker::stop()
+{
+	flush();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	running = false;
+}
+
+void PersistenceWorker::markDirty(Target *target)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(std::find(dirty.begin(), dirty.end(), target) == dirty.end())
+			dirty.push_back(target);
+
+		if(!running)
+			return;
+	}
+	schedule();
+}
+
+void PersistenceWorker::flush()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	if(running)
+	{
+		lock.unlock();
+		schedule();
+
+		lock.lock();
+		idle.wait(lock, [this] { return dirty.empty() && !scheduled; });
+		return;
+	}
+
+	requeueFailed();
+
+	std::vector<Target *> pending;
+	pending.swap(dirty);
+	lock.unlock();
+
+	std::vector<Target *> retry;
+	for(Target *target : pending)
+	{
+		if(!save(target))
+			retry.push_back(target);
+	}
+
+	lock.lock();
+	failed.insert(failed.end(), retry.begin(), retry.end());
+}
+
+bool PersistenceWorker::save(Target *target)
+{
+	std::string path = target->getFilePath();
+	if(path.empty())
+		return false;
+
+	if(!writeAtomically(path, target->serialize()))
+		return false;
+
+	target->onSaved();
+	return true;
+}
+
+bool PersistenceWorker::writeAtomically(const std::string &path, const std::string &contents)
+{
+	// the file is replaced in one rename, so a crash leaves either the old or the new contents
+	std::string tempPath = path + ".tmp";
+
+	FILE *file = fopen(tempPath.c_str(), "wb");
+	if(!file)
+		return false;
+
+	bool written = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+	written = fflush(file) == 0 && written;
+	written = fsync(fileno(file)) == 0 && written;
+	written = fclose(file) == 0 && written;
+
+	if(!written || rename(tempPath.c_str(), path.c_str()) != 0)
+	{
+		::remove(tempPath.c_str());
+		return false;
+	}
+	return true;
+}
+
+void PersistenceWorker::schedule()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		requeueFailed();
+		if(scheduled || dirty.empty())
+			return;
+
+		scheduled = true;
+	}
+
+	// submitted outside the lock, a stopped pool runs the drain right here
+	pool->submit([this] { drain(); });
+}
+
+void PersistenceWorker::drain()
+{
+	std::vector<Target *> retry;
+
+	std::unique_lock<std::mutex> lock(mutex);
+	while(!dirty.empty())
+	{
+		std::vector<Target *> batch;
+		batch.swap(dirty);
+		lock.unlock();
+
+		for(Target *target : batch)
+		{
+			if(!save(target) && std::find(retry.begin(), retry.end(), target) == retry.end())
+				retry.push_back(target);
+		}
+
+		lock.lock();
+	}
+
+	// a write that keeps failing (full disk, missing folder) is not retried in a loop here, only with the next request
+	for(Target *target : retry)
+	{
+		if(std::find(failed.begin(), failed.end(), target) == failed.end())
+			failed.push_back(target);
+	}
+
+	scheduled = false;
+	idle.notify_all();
+}
+
+void PersistenceWorker::requeueFailed()
+{
+	for(Target *target : failed)
+	{
+		if(std::find(dirty.begin(), dirty.end(), target) == dirty.end())
+			dirty.push_back(target);
+	}
+	failed.clear();
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+class ThreadPool;
+
+// writes dirty lists from the thread pool, one drain at a time so writes of a file never overlap
+class PersistenceWorker
+{
+public:
+	class Target
+	{
+	public:
+		virtual ~Target() {}
+
+		virtual std::string getFilePath() const = 0;
+		// called on the worker thread, implementations must lock against their own writers
+		virtual std::string serialize() = 0;
+		virtual void onSaved() {}
+	};
+
+private:
+	ThreadPool *pool;
+	std::mutex mutex;
+	std::condition_variable idle;
+
+	std::vector<Target *> dirty;
+	// targets whose last write failed, they go back into dirty with the next markDirty or flush
+	std::vector<Target *> failed;
+	bool running;
+	bool scheduled;
+
+public:
+	PersistenceWorker(ThreadPool *pool);
+	~PersistenceWorker();
+
+	void start();
+	void stop();
+
+	void markDirty(Target *target);
+	void flush();
+
+	static bool save(Target *target);
+	static bool writeAtomically(const std::string &path, const std::string &contents);
+
+private:
+	void schedule();
+	void drain();
+	void requeueFailed();
+};
@@ -1,4 +1,5 @@
 #include <cstdlib>
+#include <cstdarg>
 #include <algorithm>
 
 #include "SMUtil.h"
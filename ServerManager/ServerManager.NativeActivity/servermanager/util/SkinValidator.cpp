@@ -0,0 +1,71 @@
+#include "SkinValidator.h"
+#include "ThreadPool.h"
+
+SkinValidator::Request::Request(std::string &&data)
+	: data(std::move(data))
+{
+	done = false;
+	valid = false;
+}
+
+bool SkinValidator::Request::isDone() const
+{
+	return done.load(std::memory_order_acquire);
+}
+
+bool SkinValidator::Request::isValid() const
+{
+	return valid;
+}
+
+std::string &SkinValidator::Request::getData()
+{
+	return data;
+}
+
+SkinValidator::SkinValidator(ThreadPool *pool)
+{
+	this->pool = pool;
+	checkedSkins = 0;
+	rejectedSkins = 0;
+	movedBytes = 0;
+}
+
+std::shared_ptr<SkinValidator::Request> SkinValidator::submit(std::string &&data)
+{
+	std::shared_ptr<Request> request = std::make_shared<Request>(std::move(data));
+	pool->submit([this, request] { resolve(*request); }, ThreadPool::HIGH);
+	return request;
+}
+
+unsigned long long SkinValidator::getCheckedSkins() const
+{
+	return checkedSkins;
+}
+
+unsigned long long SkinValidator::getRejectedSkins() const
+{
+	return rejectedSkins;
+}
+
+unsigned long long SkinValidator::getSavedBytes() const
+{
+	return movedBytes;
+}
+
+bool SkinValidator::isValid(const std::string &data)
+{
+	return data.length() == 64 * 32 * 4 || data.length() == 64 * 64 * 4;
+}
+
+void SkinValidator::resolve(Request &request)
+{
+	request.valid = isValid(request.data);
+
+	++checkedSkins;
+	movedBytes += request.data.size();
+	if(!request.valid)
+		++rejectedSkins;
+
+	request.done.store(true, std::memory_order_release);
+}
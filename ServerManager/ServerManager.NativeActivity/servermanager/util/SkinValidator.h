@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <atomic>
+
+class ThreadPool;
+
+// checks login skins off the game thread, the skin is moved in and out so a join never copies it
+class SkinValidator
+{
+public:
+	class Request
+	{
+		friend class SkinValidator;
+
+	private:
+		std::atomic<bool> done;
+		std::string data;
+		bool valid;
+
+	public:
+		Request(std::string &&data);
+
+		bool isDone() const;
+		// false when the skin was not a valid 64x32 or 64x64 RGBA image
+		bool isValid() const;
+		std::string &getData();
+	};
+
+private:
+	ThreadPool *pool;
+
+	std::atomic<unsigned long long> checkedSkins;
+	std::atomic<unsigned long long> rejectedSkins;
+	std::atomic<unsigned long long> movedBytes;
+
+public:
+	SkinValidator(ThreadPool *pool);
+
+	std::shared_ptr<Request> submit(std::string &&data);
+
+	unsigned long long getCheckedSkins() const;
+	unsigned long long getRejectedSkins() const;
+	// skin bytes that reached the player without the copy the queued LoginPacket used to make
+	unsigned long long getSavedBytes() const;
+
+	static bool isValid(const std::string &data);
+
+private:
+	void resolve(Request &request);
+};
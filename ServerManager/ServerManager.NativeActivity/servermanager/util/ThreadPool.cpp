@@ -0,0 +1,284 @@
+#include <algorithm>
+
+#include "ThreadPool.h"
+
+thread_local ThreadPool *ThreadPool::currentPool = NULL;
+thread_local int ThreadPool::currentWorker = -1;
+
+ThreadPool::WorkDeque::WorkDeque()
+	: buffer(new std::atomic<Task *>[DEQUE_CAPACITY])
+{
+	top = 0;
+	bottom = 0;
+}
+
+bool ThreadPool::WorkDeque::push(Task *task)
+{
+	long b = bottom.load(std::memory_order_relaxed);
+	long t = top.load(std::memory_order_acquire);
+	if(b - t >= DEQUE_CAPACITY)
+		return false;
+
+	buffer[b & (DEQUE_CAPACITY - 1)].store(task, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	bottom.store(b + 1, std::memory_order_relaxed);
+	return true;
+}
+
+ThreadPool::Task *ThreadPool::WorkDeque::pop()
+{
+	long b = bottom.load(std::memory_order_relaxed) - 1;
+	bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	long t = top.load(std::memory_order_relaxed);
+
+	if(t > b)
+	{
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return NULL;
+	}
+
+	Task *task = buffer[b & (DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+	if(t == b)
+	{
+		// the last task, a thief may be taking it at the same time
+		if(!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			task = NULL;
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+	return task;
+}
+
+ThreadPool::Task *ThreadPool::WorkDeque::steal()
+{
+	long t = top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	long b = bottom.load(std::memory_order_acquire);
+	if(t >= b)
+		return NULL;
+
+	Task *task = buffer[t & (DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+	if(!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		return NULL;
+
+	return task;
+}
+
+size_t ThreadPool::WorkDeque::size() const
+{
+	long size = bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed);
+	return size > 0 ? size : 0;
+}
+
+ThreadPool::ThreadPool()
+{
+	running = false;
+	queued = 0;
+	pending = 0;
+	sleeping = 0;
+
+	submitted = 0;
+	executed = 0;
+	stolen = 0;
+}
+
+ThreadPool::~ThreadPool()
+{
+	stop();
+}
+
+void ThreadPool::start(int threads)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if(running)
+		return;
+
+	if(threads <= 0)
+		threads = std::min(std::max((int)std::thread::hardware_concurrency(), 2), (int)MAX_WORKERS);
+
+	running = true;
+	for(int i = 0; i < threads; ++i)
+		workers.push_back(std::unique_ptr<Worker>(new Worker));
+
+	// every deque exists before the first worker starts stealing from them
+	for(int i = 0; i < threads; ++i)
+		workers[i]->thread = std::thread(&ThreadPool::run, this, i);
+}
+
+void ThreadPool::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(!running)
+			return;
+	}
+
+	waitIdle();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		running = false;
+	}
+	wakeup.notify_all();
+
+	for(std::unique_ptr<Worker> &worker : workers)
+		worker->thread.join();
+
+	// anything submitted while the workers were leaving still runs, here on the calling thread
+	for(int priority = 0; priority < PRIORITY_COUNT; ++priority)
+	{
+		for(std::unique_ptr<Worker> &worker : workers)
+		{
+			while(Task *task = worker->deques[priority].pop())
+			{
+				--queued;
+				execute(task);
+			}
+		}
+
+		while(Task *task = takeInjected(priority))
+			execute(task);
+	}
+
+	workers.clear();
+}
+
+void ThreadPool::submit(const Task &task, Priority priority)
+{
+	++submitted;
+	if(!running)
+	{
+		++executed;
+		task();
+		return;
+	}
+
+	Task *newTask = new Task(task);
+	++pending;
+	++queued;
+
+	// a task spawned by a worker goes to that worker's own deque, no lock involved
+	if(currentPool == this && currentWorker >= 0 && workers[currentWorker]->deques[priority].push(newTask))
+	{
+		if(sleeping.load() > 0)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			wakeup.notify_one();
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		injected[priority].push_back(newTask);
+	}
+	wakeup.notify_one();
+}
+
+void ThreadPool::waitIdle()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	idle.wait(lock, [this] { return pending.load() == 0; });
+}
+
+bool ThreadPool::isRunning() const
+{
+	return running;
+}
+
+ThreadPool::Stats ThreadPool::getStats()
+{
+	Stats stats;
+	stats.submitted = submitted;
+	stats.executed = executed;
+	stats.stolen = stolen;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	stats.workers = workers.size();
+	for(int priority = 0; priority < PRIORITY_COUNT; ++priority)
+	{
+		stats.queued[priority] = injected[priority].size();
+		for(std::unique_ptr<Worker> &worker : workers)
+			stats.queued[priority] += worker->deques[priority].size();
+	}
+	return stats;
+}
+
+void ThreadPool::run(int index)
+{
+	currentPool = this;
+	currentWorker = index;
+
+	while(true)
+	{
+		Task *task = findTask(index);
+		if(task)
+		{
+			execute(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(mutex);
+		++sleeping;
+		wakeup.wait(lock, [this] { return !running || queued.load() > 0; });
+		--sleeping;
+
+		if(!running)
+			break;
+	}
+
+	currentPool = NULL;
+	currentWorker = -1;
+}
+
+ThreadPool::Task *ThreadPool::findTask(int index)
+{
+	// higher priorities first, and for each one the own deque, then the other workers, then the injected queue
+	for(int priority = 0; priority < PRIORITY_COUNT; ++priority)
+	{
+		Task *task = workers[index]->deques[priority].pop();
+
+		for(size_t i = 1; !task && i < workers.size(); ++i)
+		{
+			task = workers[(index + i) % workers.size()]->deques[priority].steal();
+			if(task)
+				++stolen;
+		}
+
+		if(task)
+		{
+			--queued;
+			return task;
+		}
+
+		task = takeInjected(priority);
+		if(task)
+			return task;
+	}
+	return NULL;
+}
+
+ThreadPool::Task *ThreadPool::takeInjected(int priority)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if(injected[priority].empty())
+		return NULL;
+
+	Task *task = injected[priority].front();
+	injected[priority].pop_front();
+	--queued;
+	return task;
+}
+
+void ThreadPool::execute(Task *task)
+{
+	(*task)();
+	delete task;
+	++executed;
+
+	if(--pending == 0)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		idle.notify_all();
+	}
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// work-stealing pool shared by the background parts of the server
+class ThreadPool
+{
+public:
+	typedef std::function<void()> Task;
+
+	enum Priority
+	{
+		HIGH,
+		NORMAL,
+		LOW,
+		PRIORITY_COUNT
+	};
+
+	static const int DEQUE_CAPACITY = 1024;
+	static const int MAX_WORKERS = 8;
+
+	struct Stats
+	{
+		int workers;
+		size_t queued[PRIORITY_COUNT];
+		unsigned long long submitted;
+		unsigned long long executed;
+		unsigned long long stolen;
+	};
+
+private:
+	// Chase-Lev deque, the owning worker pushes and pops at the bottom, everyone else steals from the top
+	class WorkDeque
+	{
+	private:
+		std::atomic<long> top;
+		std::atomic<long> bottom;
+		std::unique_ptr<std::atomic<Task *>[]> buffer;
+
+	public:
+		WorkDeque();
+
+		bool push(Task *task);
+		Task *pop();
+		Task *steal();
+		size_t size() const;
+	};
+
+	struct Worker
+	{
+		WorkDeque deques[PRIORITY_COUNT];
+		std::thread thread;
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers;
+
+	// submissions from outside the pool, and overflow of full deques
+	std::mutex mutex;
+	std::condition_variable wakeup;
+	std::condition_variable idle;
+	std::deque<Task *> injected[PRIORITY_COUNT];
+
+	std::atomic<bool> running;
+	// queued counts tasks nobody has picked up yet, pending also counts the ones still running
+	std::atomic<long> queued;
+	std::atomic<long> pending;
+	std::atomic<int> sleeping;
+
+	std::atomic<unsigned long long> submitted;
+	std::atomic<unsigned long long> executed;
+	std::atomic<unsigned long long> stolen;
+
+	static thread_local ThreadPool *currentPool;
+	static thread_local int currentWorker;
+
+public:
+	ThreadPool();
+	~ThreadPool();
+
+	// threads defaults to the hardware concurrency
+	void start(int threads = 0);
+	// runs whatever is still queued, then joins the workers
+	void stop();
+
+	// without workers the task runs right away on the calling thread
+	void submit(const Task &task, Priority priority = NORMAL);
+	// blocks until every submitted task has finished
+	void waitIdle();
+
+	bool isRunning() const;
+	Stats getStats();
+
+private:
+	void run(int index);
+	Task *findTask(int index);
+	Task *takeInjected(int priority);
+	void execute(Task *task);
+};
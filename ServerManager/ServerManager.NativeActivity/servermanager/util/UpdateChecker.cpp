@@ -0,0 +1,140 @@
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <curl/curl.h>
+#include <json/json.h>
+
+#include "UpdateChecker.h"
+#include "PersistenceWorker.h"
+#include "ThreadPool.h"
+
+UpdateChecker::UpdateChecker(ThreadPool *pool)
+{
+	this->pool = pool;
+	started = false;
+	finished = false;
+	found = false;
+	result.versionCode = 0;
+}
+
+void UpdateChecker::start(const std::string &url, const std::string &cachePath)
+{
+	if(started || url.empty())
+		return;
+
+	started = true;
+	this->url = url;
+	this->cachePath = cachePath;
+
+	// the fetch can block for its whole timeout, so it queues behind everything else
+	pool->submit([this] { run(); }, ThreadPool::LOW);
+}
+
+bool UpdateChecker::isFinished()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return finished;
+}
+
+bool UpdateChecker::getResult(Result &result)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!finished || !found)
+		return false;
+
+	result = this->result;
+	return true;
+}
+
+void UpdateChecker::run()
+{
+	Result parsed;
+	std::string data;
+	bool ok = readCache(data, false) && parse(data, parsed);
+	if(!ok)
+	{
+		// only a body that parses replaces the cache, a cut-off transfer or a login page keeps the last good copy
+		std::string fetched;
+		if(fetch(fetched) && parse(fetched, parsed))
+		{
+			PersistenceWorker::writeAtomically(cachePath, fetched);
+			ok = true;
+		}
+		else
+			ok = readCache(data, true) && parse(data, parsed);
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if(ok)
+		result = parsed;
+	found = ok;
+	finished = true;
+}
+
+bool UpdateChecker::readCache(std::string &data, bool allowStale) const
+{
+	struct stat info;
+	if(stat(cachePath.c_str(), &info) != 0)
+		return false;
+
+	if(!allowStale && time(NULL) - info.st_mtime > CACHE_TTL)
+		return false;
+
+	std::ifstream ifs(cachePath.c_str());
+	if(!ifs.is_open())
+		return false;
+
+	std::stringstream ss;
+	ss << ifs.rdbuf();
+	data = ss.str();
+	return !data.empty();
+}
+
+bool UpdateChecker::fetch(std::string &data) const
+{
+	CURL *curl = curl_easy_init();
+	if(!curl)
+		return false;
+
+	struct Writer
+	{
+		static size_t write(char *data, size_t size, size_t nmemb, std::string *writerData)
+		{
+			writerData->append(data, size * nmemb);
+			return size * nmemb;
+		}
+	};
+
+	curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+	curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+	curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+	curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+	curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+	curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, CONNECT_TIMEOUT);
+	curl_easy_setopt(curl, CURLOPT_TIMEOUT, TRANSFER_TIMEOUT);
+	// curl's default resolver times out with signals, which are unsafe off the main thread
+	curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &data);
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, Writer::write);
+
+	CURLcode rc = curl_easy_perform(curl);
+	curl_easy_cleanup(curl);
+
+	return rc == CURLE_OK && !data.empty();
+}
+
+bool UpdateChecker::parse(const std::string &data, Result &result)
+{
+	Json::Value root;
+	Json::Reader reader;
+	if(!reader.parse(data, root) || !root.isObject())
+		return false;
+
+	result.version = root.get("version", "").asString("");
+	result.versionCode = root.get("version-code", 0).asInt(0);
+	result.changelog.clear();
+	for(Json::Value log : root["changelog"])
+		result.changelog.push_back(log.asString(""));
+	return !result.version.empty();
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+
+class ThreadPool;
+
+class UpdateChecker
+{
+public:
+	struct Result
+	{
+		std::string version;
+		int versionCode;
+		std::vector<std::string> changelog;
+	};
+
+	static const long CONNECT_TIMEOUT = 3;
+	static const long TRANSFER_TIMEOUT = 5;
+	static const long CACHE_TTL = 6 * 60 * 60;
+
+private:
+	std::string url;
+	std::string cachePath;
+
+	ThreadPool *pool;
+	std::mutex mutex;
+	bool started;
+	bool finished;
+	bool found;
+	Result result;
+
+public:
+	UpdateChecker(ThreadPool *pool);
+
+	// url may be any scheme curl understands, file:// included
+	void start(const std::string &url, const std::string &cachePath);
+	bool isFinished();
+	bool getResult(Result &result);
+
+private:
+	void run();
+
+	bool readCache(std::string &data, bool allowStale) const;
+	bool fetch(std::string &data) const;
+	static bool parse(const std::string &data, Result &result);
+};
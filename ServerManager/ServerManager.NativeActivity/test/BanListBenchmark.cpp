@@ -0,0 +1,113 @@
+// load and lookup cost of a 100k-entry ban list against the linear scan it replaced, built on the host:
+// g++ -std=c++11 -O2 -pthread -I../servermanager BanListBenchmark.cpp ../servermanager/BanList.cpp ../servermanager/BanEntry.cpp ../servermanager/IPRangeTree.cpp ../servermanager/util/SMUtil.cpp ../servermanager/util/PersistenceWorker.cpp ../servermanager/util/ListJournal.cpp ../servermanager/util/ThreadPool.cpp -o BanListBenchmark
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <chrono>
+#include <unistd.h>
+
+#include "BanList.h"
+#include "BanEntry.h"
+#include "util/SMUtil.h"
+
+static const int ENTRIES = 100000;
+static const int LOOKUPS = 100000;
+
+static unsigned long long nowNanos()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static std::string nameOf(int i)
+{
+	return "bot" + SMUtil::toString(i);
+}
+
+static std::string addressOf(int i)
+{
+	return SMUtil::toString(10 + i / 65536) + "." + SMUtil::toString(i / 256 % 256) + "." + SMUtil::toString(i % 256) + ".1";
+}
+
+static void writeList(const std::string &path, std::string (*target)(int))
+{
+	std::ofstream ofs(path.c_str());
+	ofs << "# victim name | banned by | reason\n\n";
+	for(int i = 0; i < ENTRIES; ++i)
+		ofs << target(i) << "|console|bot wave\n";
+}
+
+// what isBanned did before the index: a compare against every entry
+static bool linearIsBanned(const BanList &list, const std::string &target)
+{
+	for(BanEntry *entry : list.getBanEntries())
+	{
+		if(!entry->getTarget().compare(target))
+			return true;
+	}
+	return false;
+}
+
+int main()
+{
+	char dir[] = "/tmp/banlist-benchmark-XXXXXX";
+	if(!mkdtemp(dir))
+	{
+		perror("mkdtemp");
+		return 1;
+	}
+
+	writeList(std::string(dir) + "/banned-players.txt", &nameOf);
+	writeList(std::string(dir) + "/banned-ips.txt", &addressOf);
+
+	BanList names("banned-players.txt");
+	BanList addresses("banned-ips.txt");
+
+	unsigned long long start = nowNanos();
+	names.load(dir);
+	unsigned long long nameLoad = nowNanos() - start;
+
+	start = nowNanos();
+	addresses.load(dir);
+	unsigned long long addressLoad = nowNanos() - start;
+
+	// half of the lookups hit, the other half are names that were never banned
+	std::vector<std::string> probes;
+	for(int i = 0; i < LOOKUPS; ++i)
+		probes.push_back(i % 2 ? nameOf(rand() % ENTRIES) : "player" + SMUtil::toString(i));
+
+	int hits = 0;
+	start = nowNanos();
+	for(const std::string &probe : probes)
+		hits += names.isBanned(probe) ? 1 : 0;
+	unsigned long long indexed = nowNanos() - start;
+
+	int linearHits = 0;
+	int linearLookups = LOOKUPS / 100;
+	start = nowNanos();
+	for(int i = 0; i < linearLookups; ++i)
+		linearHits += linearIsBanned(names, probes[i]) ? 1 : 0;
+	unsigned long long linear = nowNanos() - start;
+
+	std::vector<std::string> addressProbes;
+	for(int i = 0; i < LOOKUPS; ++i)
+		addressProbes.push_back(i % 2 ? addressOf(rand() % ENTRIES) : "192.168." + SMUtil::toString(i / 256 % 256) + "." + SMUtil::toString(i % 256));
+
+	int addressHits = 0;
+	start = nowNanos();
+	for(const std::string &probe : addressProbes)
+		addressHits += addresses.matchAddress(probe) ? 1 : 0;
+	unsigned long long matched = nowNanos() - start;
+
+	std::string command = std::string("rm -rf ") + dir;
+	system(command.c_str());
+
+	printf("entries: %d names, %d addresses\n", (int)names.getBanEntries().size(), (int)addresses.getBanEntries().size());
+	printf("load:          %8.2f ms names, %8.2f ms addresses\n", nameLoad / 1e6, addressLoad / 1e6);
+	printf("isBanned:      %8.1f ns per lookup (%d hits in %d)\n", (double)indexed / LOOKUPS, hits, LOOKUPS);
+	printf("linear scan:   %8.1f ns per lookup (%d hits in %d)\n", (double)linear / linearLookups, linearHits, linearLookups);
+	printf("matchAddress:  %8.1f ns per lookup (%d hits in %d)\n", (double)matched / LOOKUPS, addressHits, LOOKUPS);
+
+	return (int)names.getBanEntries().size() == ENTRIES && hits == LOOKUPS / 2 && addressHits == LOOKUPS / 2 ? 0 : 1;
+}
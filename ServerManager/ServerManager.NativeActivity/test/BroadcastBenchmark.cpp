@@ -0,0 +1,129 @@
+// BroadcastQueue::flush to 100 players: one TextPacket encode per recipient against one encode per distinct packet, built on the host
+// with the stand-in game and RakNet headers in stubs/ (same TextPacket wire layout, Send copies the datagram):
+// g++ -std=c++11 -O2 -Istubs -I../servermanager BroadcastBenchmark.cpp ../servermanager/network/BroadcastQueue.cpp ../servermanager/network/SerializedPacket.cpp ../servermanager/util/SMUtil.cpp -o BroadcastBenchmark
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "network/BroadcastQueue.h"
+#include "util/SMUtil.h"
+#include "minecraftpe/network/PacketSender.h"
+#include "minecraftpe/network/RakNetInstance.h"
+
+static const int RECIPIENTS = 100;
+static const int TICKS = 200;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+	do { \
+		if(!(cond)) \
+		{ \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			failures++; \
+		} \
+	} while(0)
+
+// what a plugin loop over the online players sends in one tick
+static const char *LINES[] = {
+	"[Server] Restarting in 5 minutes",
+	"[Shop] Prices have been updated, type /shop to see them",
+	"[Vote] Vote for the server to get a diamond!",
+	"Steve joined the game"
+};
+
+static unsigned long long nowNanos()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static std::vector<RakNet::RakNetGUID> makeRecipients()
+{
+	std::vector<RakNet::RakNetGUID> guids;
+	for(int i = 0; i < RECIPIENTS; ++i)
+	{
+		RakNet::RakNetGUID guid;
+		guid.g = 0x9e3779b97f4a7c15ULL * (i + 1);
+		guid.systemIndex = i;
+		guids.push_back(guid);
+	}
+	return guids;
+}
+
+static std::string personalLine(int recipient)
+{
+	return "Welcome back, Player_" + SMUtil::toString(recipient);
+}
+
+// what a plugin loop over the online players queues in one tick
+static void queueTick(BroadcastQueue &queue, const std::vector<RakNet::RakNetGUID> &guids, bool personal)
+{
+	for(const char *line : LINES)
+	{
+		for(const RakNet::RakNetGUID &guid : guids)
+			queue.queueMessage(&guid, line);
+	}
+
+	if(personal)
+	{
+		for(int i = 0; i < (int)guids.size(); ++i)
+			queue.queueMessage(&guids[i], personalLine(i));
+	}
+}
+
+// without a RakNetInstance flush hands every packet to the game, which encodes it once per recipient
+static unsigned long long flushTicks(BroadcastQueue &queue, PacketSender &sender, RakNetInstance *raknet, const std::vector<RakNet::RakNetGUID> &guids, bool personal)
+{
+	unsigned long long nanos = 0;
+	for(int tick = 0; tick < TICKS; ++tick)
+	{
+		queueTick(queue, guids, personal);
+
+		unsigned long long start = nowNanos();
+		queue.flush(&sender, raknet);
+		nanos += nowNanos() - start;
+	}
+	return nanos;
+}
+
+static void run(bool personal)
+{
+	std::vector<RakNet::RakNetGUID> guids = makeRecipients();
+
+	RakNetInstance directRaknet;
+	PacketSender directSender(&directRaknet, guids);
+	BroadcastQueue directQueue;
+	unsigned long long directNanos = flushTicks(directQueue, directSender, NULL, guids, personal);
+
+	RakNetInstance sharedRaknet;
+	PacketSender sharedSender(&sharedRaknet, guids);
+	BroadcastQueue sharedQueue;
+	unsigned long long sharedNanos = flushTicks(sharedQueue, sharedSender, &sharedRaknet, guids, personal);
+
+	// every recipient has to receive the same bytes either way
+	CHECK(directRaknet.getPeer()->sentBytes == sharedRaknet.getPeer()->sentBytes);
+	CHECK(directRaknet.getPeer()->checksum == sharedRaknet.getPeer()->checksum);
+
+	unsigned long long packets = sharedQueue.getSentPackets();
+	unsigned long long encodes = packets - sharedQueue.getSharedEncodes();
+	CHECK(directQueue.getSharedEncodes() == 0);
+	CHECK(packets == (unsigned long long)TICKS * RECIPIENTS * (sizeof(LINES) / sizeof(LINES[0]) + (personal ? 1 : 0)));
+
+	printf("%s: %llu packets per tick to %d players\n", personal ? "shared lines + one personal line" : "shared lines", packets / TICKS, RECIPIENTS);
+	printf("  encode per recipient: %8.2f us per flush, %llu encodes\n", directNanos / 1000.0 / TICKS, packets / TICKS);
+	printf("  shared encodes:       %8.2f us per flush, %llu encodes\n", sharedNanos / 1000.0 / TICKS, encodes / TICKS);
+}
+
+int main()
+{
+	run(false);
+	run(true);
+
+	if(failures > 0)
+	{
+		fprintf(stderr, "%d check(s) failed\n", failures);
+		return 1;
+	}
+	return 0;
+}
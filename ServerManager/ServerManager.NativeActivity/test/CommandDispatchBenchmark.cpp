@@ -0,0 +1,169 @@
+// replays a recorded command mix through the old split/map lookup and through CommandLine with CommandLabelTable, built on the host:
+// g++ -std=c++11 -O2 -I../servermanager CommandDispatchBenchmark.cpp ../servermanager/command/CommandLine.cpp ../servermanager/command/CommandLabelTable.cpp ../servermanager/util/SMUtil.cpp -o CommandDispatchBenchmark
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+
+#include "command/CommandLine.h"
+#include "command/CommandLabelTable.h"
+#include "util/SMUtil.h"
+
+class Command;
+
+static const int ROUNDS = 2000;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+	do { \
+		if(!(cond)) \
+		{ \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			failures++; \
+		} \
+	} while(0)
+
+// labels of the default and a few plugin commands, the table never dereferences the pointers
+static const char *LABELS[] = {
+	"help", "?", "list", "say", "me", "tell", "msg", "w", "tp", "give", "gamemode", "kill", "time", "weather",
+	"ban", "ban-ip", "banlist", "pardon", "pardon-ip", "kick", "op", "deop", "whitelist", "stop", "timings",
+	"home", "sethome", "spawn", "warp", "money", "pay", "shop", "land", "tpa", "tpaccept"
+};
+
+// taken from a server log: mostly chat-adjacent commands, some plugin commands through their prefix, a few typos
+static const char *MIX[] = {
+	"tp Steve 120 64 -30", "say hello everyone", "home", "tpa Alex", "tpaccept", "money", "pay Alex 100",
+	"list", "help 2", "gamemode 1", "essentials:home bed", "warp shop", "tell Steve see you at spawn",
+	"spawn", "TIME set day", "weather clear", "sethome  base", " home", "land buy ", "kick Griefer spamming",
+	"shop buy diamond 3", "hmoe", "ban-ip 1.2.3.4", "timings report", "me waves", "give Steve 264 64", "w Alex hi"
+};
+
+static unsigned long long nowNanos()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static Command *commandOf(size_t index)
+{
+	return (Command *)(index + 1);
+}
+
+static void checkTokenize(const std::string &line)
+{
+	std::vector<std::string> expected = SMUtil::split(line, ' ');
+
+	std::vector<CommandLine::Token> tokens;
+	CommandLine::tokenize(line, tokens);
+
+	bool same = tokens.size() == expected.size();
+	for(size_t i = 0; same && i < tokens.size(); ++i)
+		same = tokens[i].toString() == expected[i];
+
+	if(!same)
+		fprintf(stderr, "tokenize differs from SMUtil::split for \"%s\"\n", line.c_str());
+	CHECK(same);
+}
+
+static void testTokenizeMatchesSplit()
+{
+	const char *lines[] = {
+		"", " ", "  ", "a", "a b", " a", "a ", "  a", "a  ", "a  b", " a  b ", "a   b  c   ",
+		"tp Steve 120 64 -30", "sethome  base", " home", "land buy "
+	};
+	for(const char *line : lines)
+		checkTokenize(line);
+
+	// random lines over a small alphabet hit every run of spaces
+	srand(1);
+	for(int i = 0; i < 10000; ++i)
+	{
+		std::string line;
+		int length = rand() % 12;
+		for(int j = 0; j < length; ++j)
+			line += " ab"[rand() % 3];
+		checkTokenize(line);
+	}
+}
+
+int main()
+{
+	testTokenizeMatchesSplit();
+
+	std::map<std::string, Command *> knownCommands;
+	CommandLabelTable table;
+	size_t labelCount = sizeof(LABELS) / sizeof(LABELS[0]);
+	for(size_t i = 0; i < labelCount; ++i)
+	{
+		knownCommands[LABELS[i]] = commandOf(i);
+		knownCommands[std::string("essentials:") + LABELS[i]] = commandOf(i);
+		table.set(LABELS[i], commandOf(i));
+		table.set(std::string("essentials:") + LABELS[i], commandOf(i));
+	}
+
+	std::vector<std::string> lines(MIX, MIX + sizeof(MIX) / sizeof(MIX[0]));
+
+	// before: split through a stringstream, lowercase the label, find then operator[], erase the label
+	size_t oldFound = 0;
+	size_t oldArgs = 0;
+	unsigned long long start = nowNanos();
+	for(int round = 0; round < ROUNDS; ++round)
+	{
+		for(const std::string &line : lines)
+		{
+			std::vector<std::string> args = SMUtil::split(line, ' ');
+			if(args.empty())
+				continue;
+
+			std::string label = SMUtil::toLower(args[0]);
+			if(knownCommands.find(label) == knownCommands.end())
+				continue;
+
+			Command *command = knownCommands[label];
+			args.erase(args.begin());
+			oldFound += command != NULL;
+			oldArgs += args.size();
+		}
+	}
+	unsigned long long oldNanos = nowNanos() - start;
+
+	// after: spans over the line into a reused vector, the label is looked up in place
+	size_t newFound = 0;
+	size_t newArgs = 0;
+	std::vector<CommandLine::Token> tokens;
+	start = nowNanos();
+	for(int round = 0; round < ROUNDS; ++round)
+	{
+		for(const std::string &line : lines)
+		{
+			CommandLine::tokenize(line, tokens);
+			if(tokens.empty())
+				continue;
+
+			Command *command = table.find(tokens[0].data, tokens[0].length);
+			if(!command)
+				continue;
+
+			newFound++;
+			newArgs += tokens.size() - 1;
+		}
+	}
+	unsigned long long newNanos = nowNanos() - start;
+
+	CHECK(oldFound == newFound);
+	CHECK(oldArgs == newArgs);
+
+	size_t dispatched = lines.size() * ROUNDS;
+	printf("command mix: %u lines, %u resolved per round\n", (unsigned)lines.size(), (unsigned)(newFound / ROUNDS));
+	printf("split + map:           %8.1f ns per line\n", (double)oldNanos / dispatched);
+	printf("tokenize + label table: %7.1f ns per line\n", (double)newNanos / dispatched);
+
+	if(failures > 0)
+	{
+		fprintf(stderr, "%d check(s) failed\n", failures);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,182 @@
+// event dispatch with 0, 1, 10 and 100 listeners: the old copy-and-wrap path against the baked HandlerList array, built on the host:
+// g++ -std=c++11 -O2 -I../servermanager HandlerListBenchmark.cpp ../servermanager/event/HandlerList.cpp ../servermanager/event/Event.cpp ../servermanager/event/Cancellable.cpp ../servermanager/plugin/RegisteredListener.cpp ../servermanager/plugin/ListenerTimings.cpp -o HandlerListBenchmark
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "event/HandlerList.h"
+#include "event/Event.h"
+#include "event/Listener.h"
+#include "plugin/Plugin.h"
+#include "plugin/RegisteredListener.h"
+
+static const int CALLS = 200000;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+	do { \
+		if(!(cond)) \
+		{ \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			failures++; \
+		} \
+	} while(0)
+
+// only isEnabled is consulted while dispatching
+class BenchmarkPlugin : public Plugin
+{
+public:
+	bool enabled;
+
+	BenchmarkPlugin() { enabled = true; }
+
+	bool onCommand(SMPlayer *, Command *, std::string &, std::vector<std::string> &) { return false; }
+	bool onAsyncCommand(AsyncCommand &) { return false; }
+	std::string getDataFolder() { return ""; }
+	PluginDescriptionFile *getDescription() const { return NULL; }
+	void onEnable() {}
+	void onDisable() {}
+	void onLoad() {}
+	std::string getName() const { return "Benchmark"; }
+	std::string getPluginDescription() const { return ""; }
+	void saveConfig() {}
+	void saveDefaultConfig() {}
+	void saveResource(const std::string &, bool) {}
+	void reloadConfig() {}
+	Server *getServer() const { return NULL; }
+	bool isEnabled() const { return enabled; }
+};
+
+class BenchmarkEvent : public Event
+{
+public:
+	HandlerList *handlers;
+	unsigned long long handled;
+
+	BenchmarkEvent(HandlerList *handlers) { this->handlers = handlers; handled = 0; }
+
+	HandlerList *getHandlers() const { return handlers; }
+};
+
+class BenchmarkListener : public Listener
+{
+};
+
+static void onEvent(Listener *, Event &event)
+{
+	((BenchmarkEvent &)event).handled++;
+}
+
+static unsigned long long nowNanos()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// PluginManager::callEvent before the baked array: a copy of the listener vector per event
+static void oldCallEvent(Event &event)
+{
+	std::vector<RegisteredListener *> listeners = event.getHandlers()->getRegisteredListeners();
+
+	for(RegisteredListener *registration : listeners)
+	{
+		if(!registration->getPlugin()->isEnabled())
+			continue;
+
+		registration->callEvent(event);
+	}
+}
+
+static void run(int count)
+{
+	BenchmarkPlugin plugin;
+	BenchmarkListener listener;
+	std::function<void(Listener *, Event &)> func = &onEvent;
+
+	// registerEvent used to wrap the plugin's function in a second std::function
+	HandlerList oldList;
+	for(int i = 0; i < count; ++i)
+	{
+		auto executor = [func](Listener *listener, Event &event)
+		{
+			func(listener, event);
+		};
+		oldList.registerListener(new RegisteredListener(&listener, EventType::PLAYER_MOVE, executor, EventPriority::NORMAL, &plugin, false));
+	}
+
+	HandlerList newList;
+	for(int i = 0; i < count; ++i)
+		newList.registerListener(new RegisteredListener(&listener, EventType::PLAYER_MOVE, func, EventPriority::NORMAL, &plugin, false));
+
+	BenchmarkEvent oldEvent(&oldList);
+	unsigned long long start = nowNanos();
+	for(int i = 0; i < CALLS; ++i)
+		oldCallEvent(oldEvent);
+	unsigned long long oldNanos = nowNanos() - start;
+
+	BenchmarkEvent newEvent(&newList);
+	start = nowNanos();
+	for(int i = 0; i < CALLS; ++i)
+		newList.callEvent(newEvent);
+	unsigned long long newNanos = nowNanos() - start;
+
+	CHECK(oldEvent.handled == (unsigned long long)count * CALLS);
+	CHECK(newEvent.handled == (unsigned long long)count * CALLS);
+
+	printf("%3d listeners: copy + wrapped call %8.1f ns, baked array %8.1f ns per event\n", count, (double)oldNanos / CALLS, (double)newNanos / CALLS);
+
+	oldList.unregister(&plugin);
+	newList.unregister(&plugin);
+}
+
+// a listener that disables its plugin and unregisters a later one mid-dispatch
+static HandlerList *mutatedList;
+static BenchmarkPlugin *mutatedPlugin;
+static BenchmarkListener *removedListener;
+
+static void onMutate(Listener *, Event &event)
+{
+	((BenchmarkEvent &)event).handled++;
+	mutatedPlugin->enabled = false;
+	mutatedList->unregister(removedListener);
+}
+
+static void testLiveChecks()
+{
+	BenchmarkPlugin first, second;
+	BenchmarkListener mutator, removed, skipped;
+	HandlerList list;
+	mutatedList = &list;
+	mutatedPlugin = &second;
+	removedListener = &removed;
+
+	list.registerListener(new RegisteredListener(&mutator, EventType::PLAYER_MOVE, &onMutate, EventPriority::LOWEST, &first, false));
+	list.registerListener(new RegisteredListener(&removed, EventType::PLAYER_MOVE, &onEvent, EventPriority::NORMAL, &first, false));
+	list.registerListener(new RegisteredListener(&skipped, EventType::PLAYER_MOVE, &onEvent, EventPriority::HIGH, &second, false));
+
+	BenchmarkEvent event(&list);
+	list.callEvent(event);
+	CHECK(event.handled == 1);
+	CHECK(list.getRegisteredListeners().size() == 2);
+
+	list.unregister(&first);
+	list.unregister(&second);
+	CHECK(!list.hasListeners());
+}
+
+int main()
+{
+	testLiveChecks();
+
+	int counts[] = {0, 1, 10, 100};
+	for(int count : counts)
+		run(count);
+
+	if(failures > 0)
+	{
+		fprintf(stderr, "%d check(s) failed\n", failures);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,146 @@
+// parse and match checks for IPRangeTree, and range bans in BanList, built on the host:
+// g++ -std=c++11 -pthread -I../servermanager IPRangeTreeTest.cpp ../servermanager/IPRangeTree.cpp ../servermanager/BanList.cpp ../servermanager/BanEntry.cpp ../servermanager/util/SMUtil.cpp ../servermanager/util/PersistenceWorker.cpp ../servermanager/util/ListJournal.cpp ../servermanager/util/ThreadPool.cpp -o IPRangeTreeTest
+#include <cstdio>
+#include <string>
+
+#include "IPRangeTree.h"
+#include "BanList.h"
+#include "BanEntry.h"
+
+static int failures = 0;
+
+#define CHECK(cond) \
+	do { \
+		if(!(cond)) \
+		{ \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			failures++; \
+		} \
+	} while(0)
+
+static std::string canonical(const std::string &target)
+{
+	IPRangeTree::Range range;
+	if(!IPRangeTree::parse(target, range))
+		return "";
+	return IPRangeTree::format(range);
+}
+
+static void testParse()
+{
+	IPRangeTree::Range range;
+
+	CHECK(IPRangeTree::parse("1.2.3.4", range) && range.prefixLength == 128);
+	CHECK(IPRangeTree::parse("1.2.3.0/24", range) && range.prefixLength == 120);
+	CHECK(IPRangeTree::parse(" 10.0.0.0/8 ", range) && range.prefixLength == 104);
+	CHECK(IPRangeTree::parse("1.2.3.*", range) && range.prefixLength == 120);
+	CHECK(IPRangeTree::parse("1.2.*.*", range) && range.prefixLength == 112);
+	CHECK(IPRangeTree::parse("0.0.0.0/0", range) && range.prefixLength == 96);
+	CHECK(IPRangeTree::parse("2001:db8::1", range) && range.prefixLength == 128);
+	CHECK(IPRangeTree::parse("2001:db8::/32", range) && range.prefixLength == 32);
+	CHECK(IPRangeTree::parse("fe80::1%wlan0", range) && range.prefixLength == 128);
+
+	CHECK(!IPRangeTree::parse("", range));
+	CHECK(!IPRangeTree::parse("steve", range));
+	CHECK(!IPRangeTree::parse("1.2.3", range));
+	CHECK(!IPRangeTree::parse("1.2.3.256", range));
+	CHECK(!IPRangeTree::parse("1.2.3.4/33", range));
+	CHECK(!IPRangeTree::parse("1.2.3.4/-1", range));
+	CHECK(!IPRangeTree::parse("1.2.3.4/", range));
+	CHECK(!IPRangeTree::parse("1.2.3.*/24", range));
+	CHECK(!IPRangeTree::parse("2001:db8::/129", range));
+	CHECK(!IPRangeTree::parse("2001:db8::g", range));
+}
+
+static void testFormat()
+{
+	CHECK(canonical("1.2.3.4") == "1.2.3.4/32");
+	CHECK(canonical("1.2.3.*") == "1.2.3.0/24");
+	CHECK(canonical("1.2.3.5/24") == "1.2.3.0/24");
+	CHECK(canonical("::ffff:1.2.3.4") == "1.2.3.4/32");
+	CHECK(canonical("2001:db8::1/32") == "2001:db8::/32");
+	CHECK(canonical("2001:DB8:0:0::1") == "2001:db8::1/128");
+}
+
+static void testMatch()
+{
+	BanEntry single("1.2.3.4");
+	BanEntry subnet("10.0.0.0/8");
+	BanEntry narrower("10.1.0.0/16");
+	BanEntry wildcard("192.168.*.*");
+	BanEntry v6("2001:db8::/32");
+
+	IPRangeTree tree;
+	IPRangeTree::Range range;
+	IPRangeTree::parse(single.getTarget(), range);
+	tree.insert(range, &single);
+	IPRangeTree::parse(subnet.getTarget(), range);
+	tree.insert(range, &subnet);
+	IPRangeTree::parse(narrower.getTarget(), range);
+	tree.insert(range, &narrower);
+	IPRangeTree::parse(wildcard.getTarget(), range);
+	tree.insert(range, &wildcard);
+	IPRangeTree::parse(v6.getTarget(), range);
+	tree.insert(range, &v6);
+
+	CHECK(tree.match("1.2.3.4") == &single);
+	CHECK(tree.match("1.2.3.5") == NULL);
+	CHECK(tree.match("10.200.0.1") == &subnet);
+	// the longest prefix wins
+	CHECK(tree.match("10.1.2.3") == &narrower);
+	CHECK(tree.match("11.0.0.1") == NULL);
+	CHECK(tree.match("192.168.44.2") == &wildcard);
+	CHECK(tree.match("192.169.0.1") == NULL);
+	CHECK(tree.match("::ffff:10.0.0.1") == &subnet);
+	CHECK(tree.match("2001:db8:1234::5") == &v6);
+	CHECK(tree.match("2001:db9::5") == NULL);
+	CHECK(tree.match("not an address") == NULL);
+
+	IPRangeTree::parse("10.1.0.0/16", range);
+	tree.remove(range);
+	CHECK(tree.match("10.1.2.3") == &subnet);
+
+	tree.clear();
+	CHECK(tree.match("1.2.3.4") == NULL);
+}
+
+static void testBanList()
+{
+	BanList list("banned-ips.txt");
+
+	// different spellings of one range share an entry
+	list.addBan("1.2.3.*", "", "");
+	list.addBan("1.2.3.0/24", "", "");
+	CHECK(list.getBanEntries().size() == 1);
+	CHECK(list.isBanned("1.2.3.5/24"));
+	CHECK(list.matchAddress("1.2.3.9") != NULL);
+
+	list.addBan("1.2.3.4", "", "");
+	CHECK(list.isBanned("1.2.3.4/32"));
+	CHECK(list.isBanned("::ffff:1.2.3.4"));
+
+	// lifting the single address leaves the subnet in force
+	CHECK(list.pardon("1.2.3.4/32"));
+	CHECK(list.matchAddress("1.2.3.4") != NULL);
+
+	CHECK(list.pardon("1.2.3.5/24"));
+	CHECK(list.matchAddress("1.2.3.9") == NULL);
+	CHECK(!list.pardon("1.2.3.*"));
+	CHECK(list.getBanEntries().empty());
+}
+
+int main()
+{
+	testParse();
+	testFormat();
+	testMatch();
+	testBanList();
+
+	if(failures > 0)
+	{
+		fprintf(stderr, "%d check(s) failed\n", failures);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
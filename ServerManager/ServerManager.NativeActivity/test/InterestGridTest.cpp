@@ -0,0 +1,207 @@
+// neighbourhood selection and cell moves in InterestGrid, checked against a brute-force distance filter, built on the host:
+// g++ -std=c++11 -I../servermanager InterestGridTest.cpp ../servermanager/InterestGrid.cpp -o InterestGridTest
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+
+#include "InterestGrid.h"
+
+static int failures = 0;
+
+#define CHECK(cond) \
+	do { \
+		if(!(cond)) \
+		{ \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			failures++; \
+		} \
+	} while(0)
+
+// the grid never dereferences players
+static SMPlayer *playerOf(int index)
+{
+	return (SMPlayer *)(size_t)(index + 1);
+}
+
+// getRecipients sends every FAR_UPDATE_INTERVAL-th move to the whole dimension, so one call here
+// runs a full interval and returns the nearby recipients of its first move
+static std::vector<SMPlayer *> nearby(InterestGrid &grid, SMPlayer *source, std::vector<SMPlayer *> *far = NULL)
+{
+	std::vector<SMPlayer *> result, recipients;
+	for(unsigned int i = 1; i <= InterestGrid::FAR_UPDATE_INTERVAL; ++i)
+	{
+		grid.getRecipients(source, recipients);
+		if(i == 1)
+			result = recipients;
+		else if(i == InterestGrid::FAR_UPDATE_INTERVAL && far)
+			*far = recipients;
+	}
+	std::sort(result.begin(), result.end());
+	if(far)
+		std::sort(far->begin(), far->end());
+	return result;
+}
+
+static std::vector<SMPlayer *> players(std::initializer_list<int> indices)
+{
+	std::vector<SMPlayer *> result;
+	for(int index : indices)
+		result.push_back(playerOf(index));
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+static void testNeighbourhood()
+{
+	InterestGrid grid;
+	CHECK(grid.getRadius() == 160.0f);
+
+	// the source sits in cell (0, 0), cells are as wide as the radius
+	grid.update(playerOf(0), 0, 80.0f, 80.0f);
+	grid.update(playerOf(1), 0, 200.0f, 80.0f);		// cell (1, 0), 120 away
+	grid.update(playerOf(2), 0, -50.0f, 20.0f);		// cell (-1, 0), 139 away
+	grid.update(playerOf(3), 0, 170.0f, 170.0f);	// cell (1, 1), 127 away
+	grid.update(playerOf(4), 0, -50.0f, -50.0f);	// cell (-1, -1), 184 away
+	grid.update(playerOf(5), 0, 400.0f, 80.0f);		// cell (2, 0), outside the 3x3 block
+	grid.update(playerOf(6), 1, 80.0f, 80.0f);		// same spot in another dimension
+	grid.update(playerOf(7), 0, 90.0f, -150.0f);	// cell (0, -1), 230 away
+
+	std::vector<SMPlayer *> far;
+	CHECK(nearby(grid, playerOf(0), &far) == players({1, 2, 3}));
+	CHECK(far == players({1, 2, 3, 4, 5, 7}));
+
+	// the radius is inclusive and holds across cell borders
+	InterestGrid border;
+	border.update(playerOf(0), 0, 1.0f, 0.0f);
+	border.update(playerOf(1), 0, -159.0f, 0.0f);
+	border.update(playerOf(2), 0, 161.5f, 0.0f);
+	border.update(playerOf(3), 0, 0.0f, -0.5f);
+	CHECK(nearby(border, playerOf(0)) == players({1, 3}));
+
+	// an unknown source has nobody to tell
+	std::vector<SMPlayer *> recipients;
+	grid.getRecipients(playerOf(99), recipients);
+	CHECK(recipients.empty());
+}
+
+static void testMoves()
+{
+	InterestGrid grid;
+	grid.update(playerOf(0), 0, 80.0f, 80.0f);
+	grid.update(playerOf(1), 0, 200.0f, 80.0f);
+	CHECK(nearby(grid, playerOf(0)) == players({1}));
+
+	// moving within a cell still updates the distance
+	grid.update(playerOf(1), 0, 250.0f, 80.0f);
+	CHECK(nearby(grid, playerOf(0)).empty());
+
+	// across several cells and back, the player is only ever linked once
+	grid.update(playerOf(1), 0, 1000.0f, 1000.0f);
+	grid.update(playerOf(1), 0, -1000.0f, 40.0f);
+	grid.update(playerOf(1), 0, 100.0f, 100.0f);
+	CHECK(nearby(grid, playerOf(0)) == players({1}));
+	CHECK(nearby(grid, playerOf(1)) == players({0}));
+
+	// the source moving away takes its neighbourhood along
+	grid.update(playerOf(0), 0, -2000.0f, -2000.0f);
+	CHECK(nearby(grid, playerOf(0)).empty());
+	grid.update(playerOf(2), 0, -2100.0f, -1950.0f);
+	CHECK(nearby(grid, playerOf(0)) == players({2}));
+
+	// changing dimension moves the player to that dimension's cells
+	grid.update(playerOf(2), 1, -2100.0f, -1950.0f);
+	CHECK(nearby(grid, playerOf(0)).empty());
+	grid.update(playerOf(0), 1, -2000.0f, -2000.0f);
+	CHECK(nearby(grid, playerOf(0)) == players({2}));
+
+	grid.remove(playerOf(2));
+	grid.remove(playerOf(2));
+	CHECK(nearby(grid, playerOf(0)).empty());
+
+	// a larger radius rebuilds the cells around the current positions
+	grid.update(playerOf(0), 0, 80.0f, 80.0f);
+	grid.update(playerOf(3), 0, 400.0f, 80.0f);
+	CHECK(nearby(grid, playerOf(0)) == players({1}));
+	grid.setRadius(400.0f);
+	CHECK(nearby(grid, playerOf(0)) == players({1, 3}));
+	grid.setRadius(0.0f);
+	CHECK(grid.getRadius() == 400.0f);
+
+	grid.clear();
+	CHECK(nearby(grid, playerOf(0)).empty());
+}
+
+static float randomCoord()
+{
+	return (float)(rand() % 4000 - 2000) + (rand() % 100) / 100.0f;
+}
+
+static void testAgainstBruteForce()
+{
+	const int COUNT = 200;
+
+	struct Position
+	{
+		int dimension;
+		float x;
+		float z;
+	};
+
+	srand(1);
+	InterestGrid grid;
+	std::vector<Position> positions(COUNT);
+
+	for(int step = 0; step < 50; ++step)
+	{
+		// a quarter of the players move each step, some far, some across a border, some between dimensions
+		for(int i = 0; i < COUNT; ++i)
+		{
+			if(step > 0 && rand() % 4)
+				continue;
+
+			Position &position = positions[i];
+			if(step == 0 || rand() % 2)
+			{
+				position.dimension = rand() % 10 ? 0 : 1;
+				position.x = randomCoord();
+				position.z = randomCoord();
+			}
+			else
+			{
+				position.x += rand() % 64 - 32;
+				position.z += rand() % 64 - 32;
+			}
+			grid.update(playerOf(i), position.dimension, position.x, position.z);
+		}
+
+		for(int i = 0; i < COUNT; i += 7)
+		{
+			std::vector<SMPlayer *> expected;
+			for(int j = 0; j < COUNT; ++j)
+			{
+				float distX = positions[j].x - positions[i].x;
+				float distZ = positions[j].z - positions[i].z;
+				if(j != i && positions[j].dimension == positions[i].dimension && distX * distX + distZ * distZ <= grid.getRadius() * grid.getRadius())
+					expected.push_back(playerOf(j));
+			}
+			std::sort(expected.begin(), expected.end());
+			CHECK(nearby(grid, playerOf(i)) == expected);
+		}
+	}
+}
+
+int main()
+{
+	testNeighbourhood();
+	testMoves();
+	testAgainstBruteForce();
+
+	if(failures > 0)
+	{
+		fprintf(stderr, "%d check(s) failed\n", failures);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,223 @@
+// replays synthetic packet streams through PacketRateLimiter: per-id budgets, violation decay and escalation to a kick, built on the host:
+// g++ -std=c++11 -I../servermanager PacketRateLimiterTest.cpp ../servermanager/network/PacketRateLimiter.cpp -o PacketRateLimiterTest
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+#include "network/PacketRateLimiter.h"
+#include "network/PacketID.h"
+
+static int failures = 0;
+
+#define CHECK(cond) \
+	do { \
+		if(!(cond)) \
+		{ \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			failures++; \
+		} \
+	} while(0)
+
+struct Received
+{
+	unsigned long long millis;
+	unsigned long long guid;
+	int packetId;
+};
+
+struct Outcome
+{
+	int allowed;
+	int dropped;
+	int kicks;
+	unsigned long long firstKick;
+};
+
+// a client sending one packet id at a steady rate
+static void addStream(std::vector<Received> &stream, unsigned long long guid, int packetId, int perSecond, unsigned long long fromMillis, unsigned long long toMillis)
+{
+	for(unsigned long long i = 0;; ++i)
+	{
+		unsigned long long millis = fromMillis + i * 1000 / perSecond;
+		if(millis >= toMillis)
+			break;
+		Received packet = {millis, guid, packetId};
+		stream.push_back(packet);
+	}
+}
+
+static void replay(PacketRateLimiter &limiter, std::vector<Received> &stream, unsigned long long guid, Outcome &outcome)
+{
+	std::stable_sort(stream.begin(), stream.end(), [](const Received &a, const Received &b) { return a.millis < b.millis; });
+
+	outcome.allowed = 0;
+	outcome.dropped = 0;
+	outcome.kicks = 0;
+	outcome.firstKick = 0;
+
+	for(const Received &packet : stream)
+	{
+		PacketRateLimiter::Verdict verdict = limiter.check(packet.guid, packet.packetId, packet.millis);
+		if(packet.guid != guid)
+			continue;
+
+		if(verdict == PacketRateLimiter::ALLOW)
+			outcome.allowed++;
+		else if(verdict == PacketRateLimiter::DROP)
+			outcome.dropped++;
+		else if(outcome.kicks++ == 0)
+			outcome.firstKick = packet.millis;
+	}
+}
+
+static void testBudgets()
+{
+	PacketRateLimiter limiter;
+
+	// chat has a burst of 10, movement keeps its own much larger bucket
+	for(int i = 0; i < 10; ++i)
+		CHECK(limiter.check(1, PACKET_TEXT, 0) == PacketRateLimiter::ALLOW);
+	CHECK(limiter.check(1, PACKET_TEXT, 0) == PacketRateLimiter::DROP);
+	CHECK(limiter.check(1, PACKET_MOVE_PLAYER, 0) == PacketRateLimiter::ALLOW);
+	CHECK(limiter.check(2, PACKET_TEXT, 0) == PacketRateLimiter::ALLOW);
+
+	// 4 per second refills one token every 250 ms
+	CHECK(limiter.check(1, PACKET_TEXT, 200) == PacketRateLimiter::DROP);
+	CHECK(limiter.check(1, PACKET_TEXT, 450) == PacketRateLimiter::ALLOW);
+	CHECK(limiter.check(1, PACKET_TEXT, 450) == PacketRateLimiter::DROP);
+
+	// the bucket never holds more than its burst
+	for(int i = 0; i < 10; ++i)
+		CHECK(limiter.check(1, PACKET_TEXT, 60000) == PacketRateLimiter::ALLOW);
+	CHECK(limiter.check(1, PACKET_TEXT, 60000) == PacketRateLimiter::DROP);
+
+	// a zero rate turns the limit off for that id
+	limiter.setBudget(PACKET_ANIMATE, 0.0f, 0.0f);
+	for(int i = 0; i < 1000; ++i)
+		CHECK(limiter.check(1, PACKET_ANIMATE, 0) == PacketRateLimiter::ALLOW);
+
+	const PacketRateLimiter::Counters &counters = limiter.getCounters();
+	CHECK(counters.dropped == 4);
+	CHECK(counters.kicked == 0);
+	CHECK(limiter.getDroppedById().size() == 1);
+	CHECK(limiter.getDroppedById().at(PACKET_TEXT) == 4);
+
+	// a reconnect starts with full buckets
+	limiter.remove(1);
+	CHECK(limiter.check(1, PACKET_TEXT, 60000) == PacketRateLimiter::ALLOW);
+
+	limiter.resetCounters();
+	CHECK(limiter.getCounters().allowed == 0 && limiter.getDroppedById().empty());
+}
+
+static void testNormalPlay()
+{
+	PacketRateLimiter limiter;
+	std::vector<Received> stream;
+
+	// a player walking, chatting and swinging for ten minutes, next to a second player doing the same
+	for(unsigned long long guid = 1; guid <= 2; ++guid)
+	{
+		addStream(stream, guid, PACKET_MOVE_PLAYER, 20, guid, 600000);
+		addStream(stream, guid, PACKET_TEXT, 1, guid * 7, 600000);
+		addStream(stream, guid, PACKET_ANIMATE, 8, guid * 3, 600000);
+		addStream(stream, guid, PACKET_USE_ITEM, 5, guid * 11, 600000);
+	}
+
+	Outcome outcome;
+	replay(limiter, stream, 1, outcome);
+	CHECK(outcome.dropped == 0);
+	CHECK(outcome.kicks == 0);
+	CHECK(outcome.allowed == (int)(stream.size() / 2));
+}
+
+static void testDecay()
+{
+	PacketRateLimiter limiter;
+	std::vector<Received> stream;
+
+	// 12 chat lines a second drops 8 of them, fewer violations than the 10 a second that wear off
+	addStream(stream, 1, PACKET_TEXT, 12, 0, 600000);
+
+	Outcome outcome;
+	replay(limiter, stream, 1, outcome);
+	CHECK(outcome.kicks == 0);
+	CHECK(outcome.dropped > 0);
+	// about 4 a second get through, plus the initial burst
+	CHECK(outcome.allowed >= 4 * 600 && outcome.allowed <= 4 * 600 + 11);
+
+	// the same client in short bursts well apart is never close to the threshold either
+	PacketRateLimiter bursty;
+	std::vector<Received> bursts;
+	for(unsigned long long second = 0; second < 600; second += 20)
+		addStream(bursts, 1, PACKET_TEXT, 60, second * 1000, second * 1000 + 1000);
+	replay(bursty, bursts, 1, outcome);
+	CHECK(outcome.kicks == 0);
+	CHECK(outcome.dropped > 0);
+}
+
+static void testEscalation()
+{
+	PacketRateLimiter limiter;
+
+	// everything past the burst at one instant is a violation, the hundredth one kicks
+	for(int i = 0; i < 10; ++i)
+		CHECK(limiter.check(1, PACKET_TEXT, 1000) == PacketRateLimiter::ALLOW);
+	for(int i = 1; i < 100; ++i)
+		CHECK(limiter.check(1, PACKET_TEXT, 1000) == PacketRateLimiter::DROP);
+	CHECK(limiter.check(1, PACKET_TEXT, 1000) == PacketRateLimiter::KICK);
+
+	const PacketRateLimiter::Counters &counters = limiter.getCounters();
+	CHECK(counters.allowed == 10);
+	CHECK(counters.dropped == 99);
+	CHECK(counters.kicked == 1);
+	CHECK(limiter.getDroppedById().at(PACKET_TEXT) == 100);
+
+	// the kicked connection is forgotten
+	CHECK(limiter.check(1, PACKET_TEXT, 1000) == PacketRateLimiter::ALLOW);
+
+	// a sustained spammer among normal players is kicked within a few seconds, the others never
+	PacketRateLimiter mixed;
+	std::vector<Received> stream;
+	addStream(stream, 1, PACKET_TEXT, 50, 0, 60000);
+	addStream(stream, 1, PACKET_MOVE_PLAYER, 20, 0, 60000);
+	addStream(stream, 2, PACKET_TEXT, 1, 0, 60000);
+	addStream(stream, 2, PACKET_MOVE_PLAYER, 20, 0, 60000);
+
+	Outcome spammer;
+	replay(mixed, stream, 1, spammer);
+	CHECK(spammer.kicks > 0);
+	// 46 violations a second against 10 wearing off reaches 100 after about three seconds
+	CHECK(spammer.firstKick >= 2000 && spammer.firstKick <= 4000);
+
+	PacketRateLimiter mixedAgain;
+	Outcome bystander;
+	replay(mixedAgain, stream, 2, bystander);
+	CHECK(bystander.dropped == 0 && bystander.kicks == 0);
+
+	// without a threshold a flood is only ever dropped
+	PacketRateLimiter lenient;
+	lenient.setKickThreshold(0.0f);
+	std::vector<Received> flood;
+	addStream(flood, 1, PACKET_TEXT, 500, 0, 10000);
+	Outcome dropped;
+	replay(lenient, flood, 1, dropped);
+	CHECK(dropped.kicks == 0);
+	CHECK(dropped.dropped == (int)flood.size() - dropped.allowed);
+}
+
+int main()
+{
+	testBudgets();
+	testNormalPlay();
+	testDecay();
+	testEscalation();
+
+	if(failures > 0)
+	{
+		fprintf(stderr, "%d check(s) failed\n", failures);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
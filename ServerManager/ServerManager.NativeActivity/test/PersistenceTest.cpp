@@ -0,0 +1,217 @@
+// crash-consistency checks for PersistenceWorker and ListJournal, built on the host:
+// g++ -std=c++11 -pthread -I../servermanager PersistenceTest.cpp ../servermanager/util/PersistenceWorker.cpp ../servermanager/util/ListJournal.cpp ../servermanager/util/ThreadPool.cpp -o PersistenceTest
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "util/PersistenceWorker.h"
+#include "util/ListJournal.h"
+#include "util/ThreadPool.h"
+
+static int failures = 0;
+
+#define CHECK(cond) \
+	do { \
+		if(!(cond)) \
+		{ \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			failures++; \
+		} \
+	} while(0)
+
+static std::string readFile(const std::string &path)
+{
+	std::ifstream ifs(path.c_str(), std::ios::binary);
+	std::stringstream contents;
+	contents << ifs.rdbuf();
+	return contents.str();
+}
+
+static void writeFile(const std::string &path, const std::string &contents)
+{
+	std::ofstream ofs(path.c_str(), std::ios::binary | std::ios::trunc);
+	ofs << contents;
+}
+
+static bool exists(const std::string &path)
+{
+	struct stat st;
+	return stat(path.c_str(), &st) == 0;
+}
+
+static std::vector<std::string> replay(const std::string &path)
+{
+	ListJournal journal;
+	journal.open(path);
+
+	std::vector<std::string> list;
+	journal.replay([&list](char op, const std::string &record) {
+		if(op == ListJournal::OP_ADD)
+			list.push_back(record);
+		else
+			list.erase(std::remove(list.begin(), list.end(), record), list.end());
+	});
+	return list;
+}
+
+static void testInterruptedWrite(const std::string &dir)
+{
+	std::string path = dir + "/banned-players.txt";
+	writeFile(path, "steve\nalex\n");
+
+	// the process died after writing part of the temp file but before the rename
+	writeFile(path + ".tmp", "ste");
+	CHECK(readFile(path) == "steve\nalex\n");
+
+	// the next save overwrites the leftover temp file and replaces the list in one step
+	CHECK(PersistenceWorker::writeAtomically(path, "steve\n"));
+	CHECK(readFile(path) == "steve\n");
+	CHECK(!exists(path + ".tmp"));
+
+	// a temp file that cannot be written must not touch the old contents
+	mkdir((path + ".tmp").c_str(), 0755);
+	CHECK(!PersistenceWorker::writeAtomically(path, "herobrine\n"));
+	CHECK(readFile(path) == "steve\n");
+	rmdir((path + ".tmp").c_str());
+}
+
+static void testReplayAfterRotation(const std::string &dir)
+{
+	std::string path = dir + "/ops.txt.journal";
+	{
+		ListJournal journal;
+		journal.open(path);
+		journal.append(ListJournal::OP_ADD, "steve");
+		journal.append(ListJournal::OP_ADD, "alex");
+		journal.append(ListJournal::OP_REMOVE, "steve");
+
+		// compaction started, then the process died before the snapshot was written
+		journal.rotate();
+		journal.append(ListJournal::OP_ADD, "notch");
+	}
+	CHECK(exists(path + ".old"));
+
+	std::vector<std::string> list = replay(path);
+	CHECK(list.size() == 2);
+	CHECK(list.size() == 2 && list[0] == "alex" && list[1] == "notch");
+
+	// a second rotation before the first finished keeps both generations in order
+	{
+		ListJournal journal;
+		journal.open(path);
+		journal.rotate();
+		journal.append(ListJournal::OP_REMOVE, "alex");
+	}
+	list = replay(path);
+	CHECK(list.size() == 1 && list[0] == "notch");
+
+	// once the snapshot is saved only the live journal is replayed
+	{
+		ListJournal journal;
+		journal.open(path);
+		journal.finishCompaction();
+	}
+	CHECK(!exists(path + ".old"));
+	list = replay(path);
+	CHECK(list.empty());
+}
+
+static void testTornRecord(const std::string &dir)
+{
+	std::string path = dir + "/white-list.txt.journal";
+	{
+		ListJournal journal;
+		journal.open(path);
+		journal.append(ListJournal::OP_ADD, "steve");
+		journal.append(ListJournal::OP_ADD, "alex");
+	}
+
+	// the last append was cut off before its newline reached the disk
+	FILE *file = fopen(path.c_str(), "ab");
+	fputs("+herob", file);
+	fclose(file);
+
+	std::vector<std::string> list = replay(path);
+	CHECK(list.size() == 2);
+	CHECK(std::find(list.begin(), list.end(), "herob") == list.end());
+}
+
+class CountingTarget : public PersistenceWorker::Target
+{
+public:
+	std::string path;
+	int saved;
+
+	CountingTarget(const std::string &path) { this->path = path; saved = 0; }
+
+	std::string getFilePath() const { return path; }
+	std::string serialize() { return "steve\n"; }
+	void onSaved() { saved++; }
+};
+
+static void testFailedSaveIsRetried(const std::string &dir, bool running)
+{
+	ThreadPool pool;
+	if(running)
+		pool.start();
+
+	PersistenceWorker worker(&pool);
+	if(running)
+		worker.start();
+
+	// the folder is missing, so the write fails and the list has to stay dirty
+	std::string folder = dir + (running ? "/running" : "/stopped");
+	CountingTarget target(folder + "/ops.txt");
+	worker.markDirty(&target);
+	worker.flush();
+	CHECK(target.saved == 0);
+	CHECK(!exists(target.path));
+
+	// every flush tries it once more, and gives up again instead of spinning
+	worker.flush();
+	CHECK(target.saved == 0);
+
+	mkdir(folder.c_str(), 0755);
+	worker.flush();
+	CHECK(target.saved == 1);
+	CHECK(readFile(target.path) == "steve\n");
+
+	worker.flush();
+	CHECK(target.saved == 1);
+
+	worker.stop();
+	pool.stop();
+}
+
+int main()
+{
+	char dir[] = "/tmp/persistence-test-XXXXXX";
+	if(!mkdtemp(dir))
+	{
+		perror("mkdtemp");
+		return 1;
+	}
+
+	testInterruptedWrite(dir);
+	testReplayAfterRotation(dir);
+	testTornRecord(dir);
+	testFailedSaveIsRetried(dir, true);
+	testFailedSaveIsRetried(dir, false);
+
+	std::string command = std::string("rm -rf ") + dir;
+	system(command.c_str());
+
+	if(failures > 0)
+	{
+		fprintf(stderr, "%d check(s) failed\n", failures);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,155 @@
+// Server's player lookups through PlayerRegistry against the linear scans they replaced, at 1, 16, 64 and 256 players, built on the host:
+// g++ -std=c++11 -O2 -I../servermanager PlayerLookupBenchmark.cpp ../servermanager/PlayerRegistry.cpp ../servermanager/util/SMUtil.cpp -o PlayerLookupBenchmark
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "PlayerRegistry.h"
+#include "util/SMUtil.h"
+
+static const int LOOKUPS = 200000;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+	do { \
+		if(!(cond)) \
+		{ \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			failures++; \
+		} \
+	} while(0)
+
+// stands in for SMPlayer, the registry only stores the pointers
+struct SimulatedPlayer
+{
+	Player *handle;
+	unsigned long long guid;
+	std::string name;
+};
+
+static unsigned long long nowNanos()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// the old Server::getPlayer(Player *)
+static SimulatedPlayer *scanHandle(std::vector<SimulatedPlayer *> &players, Player *handle)
+{
+	for(SimulatedPlayer *player : players)
+	{
+		if(player->handle == handle)
+			return player;
+	}
+	return NULL;
+}
+
+// the GUID compare onDisconnect used to run over every player
+static SimulatedPlayer *scanGuid(std::vector<SimulatedPlayer *> &players, unsigned long long guid)
+{
+	for(SimulatedPlayer *player : players)
+	{
+		if(player->guid == guid)
+			return player;
+	}
+	return NULL;
+}
+
+// the old getPlayerExact, which lowercased every online name on each call
+static SimulatedPlayer *scanName(std::vector<SimulatedPlayer *> &players, const std::string &name)
+{
+	std::string lname = SMUtil::toLower(name);
+	for(SimulatedPlayer *player : players)
+	{
+		if(SMUtil::toLower(player->name) == lname)
+			return player;
+	}
+	return NULL;
+}
+
+static void run(int count)
+{
+	static char handles[256];
+
+	std::vector<SimulatedPlayer> storage(count);
+	std::vector<SimulatedPlayer *> players;
+	PlayerRegistry registry;
+	for(int i = 0; i < count; ++i)
+	{
+		SimulatedPlayer &player = storage[i];
+		player.handle = (Player *)&handles[i];
+		player.guid = 0x9e3779b97f4a7c15ULL * (i + 1);
+		player.name = "Player_" + SMUtil::toString(i);
+		players.push_back(&player);
+		CHECK(registry.add((SMPlayer *)&player, player.handle, player.guid, player.name));
+	}
+
+	std::vector<int> probes;
+	for(int i = 0; i < LOOKUPS; ++i)
+		probes.push_back((int)((i * 2654435761U) % count));
+
+	// commands type names in any case
+	std::vector<std::string> upperNames;
+	for(int i = 0; i < count; ++i)
+		upperNames.push_back("PLAYER_" + SMUtil::toString(i));
+
+	size_t found = 0;
+	unsigned long long start = nowNanos();
+	for(int probe : probes)
+		found += scanHandle(players, storage[probe].handle) != NULL;
+	for(int probe : probes)
+		found += scanGuid(players, storage[probe].guid) != NULL;
+	for(int probe : probes)
+		found += scanName(players, upperNames[probe]) != NULL;
+	unsigned long long scanned = nowNanos() - start;
+
+	size_t indexedFound = 0;
+	start = nowNanos();
+	for(int probe : probes)
+		indexedFound += registry.getByHandle(storage[probe].handle) == (SMPlayer *)&storage[probe];
+	for(int probe : probes)
+		indexedFound += registry.getByGuid(storage[probe].guid) == (SMPlayer *)&storage[probe];
+	for(int probe : probes)
+		indexedFound += registry.getByName(upperNames[probe]) == (SMPlayer *)&storage[probe];
+	unsigned long long indexed = nowNanos() - start;
+
+	CHECK(found == (size_t)LOOKUPS * 3);
+	CHECK(indexedFound == (size_t)LOOKUPS * 3);
+
+	printf("%3d players: linear %8.1f ns, indexed %6.1f ns per lookup\n", count, (double)scanned / (LOOKUPS * 3), (double)indexed / (LOOKUPS * 3));
+}
+
+static void testRemove()
+{
+	static char handles[2];
+	PlayerRegistry registry;
+	SimulatedPlayer oldSession, newSession;
+
+	// a relog reuses the name while the old session is still being removed
+	CHECK(registry.add((SMPlayer *)&oldSession, (Player *)&handles[0], 1, "Steve"));
+	CHECK(!registry.add((SMPlayer *)&oldSession, (Player *)&handles[0], 1, "Steve"));
+	CHECK(registry.add((SMPlayer *)&newSession, (Player *)&handles[1], 2, "steve"));
+	registry.remove((SMPlayer *)&oldSession, (Player *)&handles[0], 1, "Steve");
+
+	CHECK(registry.getByHandle((Player *)&handles[0]) == NULL);
+	CHECK(registry.getByGuid(1) == NULL);
+	CHECK(registry.getByName("STEVE") == (SMPlayer *)&newSession);
+	CHECK(registry.getByGuid(2) == (SMPlayer *)&newSession);
+}
+
+int main()
+{
+	testRemove();
+
+	int counts[] = {1, 16, 64, 256};
+	for(int count : counts)
+		run(count);
+
+	if(failures > 0)
+	{
+		fprintf(stderr, "%d check(s) failed\n", failures);
+		return 1;
+	}
+	return 0;
+}
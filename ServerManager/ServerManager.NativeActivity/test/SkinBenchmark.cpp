@@ -0,0 +1,114 @@
+// 100 joins with 16 KiB skins: the copying join path against SkinValidator, built on the host:
+// g++ -std=c++11 -O2 -pthread -I../servermanager SkinBenchmark.cpp ../servermanager/util/SkinValidator.cpp ../servermanager/util/ThreadPool.cpp -o SkinBenchmark
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "util/SkinValidator.h"
+#include "util/ThreadPool.h"
+
+static const int JOINS = 100;
+static const size_t SKIN_SIZE = 64 * 64 * 4;
+
+static std::atomic<unsigned long long> allocatedBytes(0);
+
+void *operator new(size_t size)
+{
+	allocatedBytes += size;
+	void *p = malloc(size);
+	if(!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void *p) noexcept
+{
+	free(p);
+}
+
+static unsigned long long nowNanos()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// the packets the game hands to handleLogin, each with its own skin
+static std::vector<std::string> makeSkins()
+{
+	std::vector<std::string> skins;
+	for(int i = 0; i < JOINS; ++i)
+		skins.push_back(std::string(SKIN_SIZE, (char)('a' + i % 8)));
+	return skins;
+}
+
+int main()
+{
+	// before: the queued LoginPacket copied the skin and the size check ran on the game thread
+	std::vector<std::string> skins = makeSkins();
+	std::vector<std::string> queued;
+	queued.reserve(JOINS);
+
+	unsigned long long bytesBefore = allocatedBytes;
+	unsigned long long start = nowNanos();
+	int valid = 0;
+	for(int i = 0; i < JOINS; ++i)
+	{
+		queued.push_back(skins[i]);
+		if(SkinValidator::isValid(queued.back()))
+			++valid;
+	}
+	unsigned long long copyNanos = nowNanos() - start;
+	unsigned long long copyBytes = allocatedBytes - bytesBefore;
+
+	// after: the skin is moved out of the game's packet, checked on the pool and moved back
+	skins = makeSkins();
+	ThreadPool pool;
+	pool.start();
+	SkinValidator validator(&pool);
+
+	std::vector<std::shared_ptr<SkinValidator::Request>> requests;
+	requests.reserve(JOINS);
+	std::vector<std::string> joined(JOINS);
+
+	bytesBefore = allocatedBytes;
+	start = nowNanos();
+	for(int i = 0; i < JOINS; ++i)
+		requests.push_back(validator.submit(std::move(skins[i])));
+	unsigned long long submitNanos = nowNanos() - start;
+
+	for(std::shared_ptr<SkinValidator::Request> &request : requests)
+	{
+		while(!request->isDone())
+			std::this_thread::yield();
+	}
+
+	start = nowNanos();
+	int validAfter = 0;
+	for(int i = 0; i < JOINS; ++i)
+	{
+		joined[i] = std::move(requests[i]->getData());
+		if(requests[i]->isValid())
+			++validAfter;
+	}
+	unsigned long long takeNanos = nowNanos() - start;
+	unsigned long long moveBytes = allocatedBytes - bytesBefore;
+
+	pool.stop();
+
+	unsigned long long skinBytes = 0;
+	for(std::string &skin : joined)
+		skinBytes += skin.size();
+
+	printf("joins: %d, skin size: %u bytes, valid: %d / %d\n", JOINS, (unsigned)SKIN_SIZE, valid, validAfter);
+	printf("copying path:  %8.2f us on the game thread, %8llu bytes allocated\n", copyNanos / 1000.0, copyBytes);
+	printf("validator:     %8.2f us on the game thread, %8llu bytes allocated (pool tasks included)\n", (submitNanos + takeNanos) / 1000.0, moveBytes);
+	printf("memory saved:  %llu bytes of skin copies (%llu KiB), skins held after the joins: %llu KiB\n",
+		copyBytes > moveBytes ? copyBytes - moveBytes : 0, (copyBytes > moveBytes ? copyBytes - moveBytes : 0) / 1024, skinBytes / 1024);
+
+	return valid == JOINS && validAfter == JOINS ? 0 : 1;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+
+#include "RakNetInstance.h"
+
+// host stand-in for the game's server-side sender, a broadcast goes to every connected GUID
+class PacketSender
+{
+private:
+	RakNetInstance *raknet;
+	std::vector<RakNet::RakNetGUID> connected;
+
+public:
+	PacketSender(RakNetInstance *raknet, const std::vector<RakNet::RakNetGUID> &connected)
+	{
+		this->raknet = raknet;
+		this->connected = connected;
+	}
+
+	void send(const Packet &packet)
+	{
+		for(const RakNet::RakNetGUID &guid : connected)
+			raknet->send(guid, packet);
+	}
+
+	void send(const RakNet::RakNetGUID &guid, const Packet &packet)
+	{
+		raknet->send(guid, packet);
+	}
+};
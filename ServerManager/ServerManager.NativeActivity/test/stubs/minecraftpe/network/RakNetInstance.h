@@ -0,0 +1,24 @@
+#pragma once
+
+#include "raknet/RakPeerInterface.h"
+#include "protocol/Packet.h"
+
+// host stand-in: send encodes into a fresh stream per call, as the game's RakNetInstance does
+class RakNetInstance
+{
+private:
+	RakNet::RakPeerInterface peer;
+
+public:
+	RakNet::RakPeerInterface *getPeer()
+	{
+		return &peer;
+	}
+
+	void send(const RakNet::RakNetGUID &guid, const Packet &packet)
+	{
+		RakNet::BitStream stream;
+		packet.write(&stream);
+		peer.Send(&stream, packet.priority, packet.reliability, 0, guid, false);
+	}
+};
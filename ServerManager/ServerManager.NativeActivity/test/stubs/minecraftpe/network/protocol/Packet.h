@@ -0,0 +1,23 @@
+#pragma once
+
+#include "raknet/BitStream.h"
+#include "raknet/PacketPriority.h"
+
+// host stand-in
+class Packet
+{
+public:
+	PacketPriority priority;
+	PacketReliability reliability;
+
+	Packet()
+	{
+		priority = HIGH_PRIORITY;
+		reliability = RELIABLE_ORDERED;
+	}
+
+	virtual ~Packet() {}
+
+	virtual int getId() const = 0;
+	virtual void write(RakNet::BitStream *stream) const = 0;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Packet.h"
+
+// host stand-in with the game's wire layout: id, type, then length-prefixed strings depending on the type
+class TextPacket : public Packet
+{
+public:
+	enum Type : unsigned char
+	{
+		TYPE_RAW,
+		TYPE_CHAT,
+		TYPE_TRANSLATION,
+		TYPE_POPUP,
+		TYPE_TIP,
+		TYPE_SYSTEM
+	};
+
+	Type type;
+	std::string source;
+	std::string message;
+	std::vector<std::string> params;
+
+	TextPacket()
+	{
+		type = TYPE_RAW;
+	}
+
+	int getId() const
+	{
+		return 0x93;
+	}
+
+	void write(RakNet::BitStream *stream) const
+	{
+		stream->Write((unsigned char)getId());
+		stream->Write((unsigned char)type);
+		switch(type)
+		{
+		case TYPE_POPUP:
+		case TYPE_CHAT:
+			writeString(stream, source);
+			writeString(stream, message);
+			break;
+		case TYPE_TRANSLATION:
+			writeString(stream, message);
+			stream->Write((unsigned char)params.size());
+			for(const std::string &param : params)
+				writeString(stream, param);
+			break;
+		default:
+			writeString(stream, message);
+			break;
+		}
+	}
+
+private:
+	static void writeString(RakNet::BitStream *stream, const std::string &value)
+	{
+		stream->Write((unsigned char)(value.size() >> 8));
+		stream->Write((unsigned char)value.size());
+		stream->Write(value.data(), value.size());
+	}
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include <cstring>
+
+// host stand-in: a growing byte buffer, enough for packets that only write whole bytes
+namespace RakNet
+{
+	class BitStream
+	{
+	private:
+		std::vector<unsigned char> data;
+
+	public:
+		void Write(unsigned char value)
+		{
+			data.push_back(value);
+		}
+
+		void Write(const char *bytes, unsigned int length)
+		{
+			data.insert(data.end(), bytes, bytes + length);
+		}
+
+		const unsigned char *GetData() const
+		{
+			return data.data();
+		}
+
+		unsigned int GetNumberOfBytesUsed() const
+		{
+			return data.size();
+		}
+	};
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+// host stand-in
+enum PacketPriority
+{
+	IMMEDIATE_PRIORITY,
+	HIGH_PRIORITY,
+	MEDIUM_PRIORITY,
+	LOW_PRIORITY
+};
+
+enum PacketReliability
+{
+	UNRELIABLE,
+	UNRELIABLE_SEQUENCED,
+	RELIABLE,
+	RELIABLE_ORDERED,
+	RELIABLE_SEQUENCED
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+// host stand-in
+namespace RakNet
+{
+	struct RakNetGUID
+	{
+		unsigned long long g;
+		unsigned short systemIndex;
+	};
+}
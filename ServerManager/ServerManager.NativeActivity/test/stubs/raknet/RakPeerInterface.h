@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+#include "BitStream.h"
+#include "PacketPriority.h"
+#include "RakNetTypes.h"
+
+// host stand-in: Send copies the datagram like RakNet does, and keeps a checksum of what each GUID received
+namespace RakNet
+{
+	class RakPeerInterface
+	{
+	public:
+		std::vector<unsigned char> lastDatagram;
+		unsigned long long sentBytes;
+		unsigned long long checksum;
+
+		RakPeerInterface()
+		{
+			sentBytes = 0;
+			checksum = 0;
+		}
+
+		unsigned int Send(const BitStream *stream, PacketPriority, PacketReliability, char, const RakNetGUID &guid, bool)
+		{
+			lastDatagram.assign(stream->GetData(), stream->GetData() + stream->GetNumberOfBytesUsed());
+			sentBytes += lastDatagram.size();
+
+			unsigned long long sum = guid.g;
+			for(unsigned char byte : lastDatagram)
+				sum = sum * 31 + byte;
+			checksum += sum;
+			return lastDatagram.size();
+		}
+	};
+}